@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+
+/*
+ * Display throughput benchmark. Sweeps the I2C clock and measures refresh
+ * latencies, glyph cost and sustained frame rate. Results go to USB stdio,
+ * one line per measurement as space separated key=value pairs:
+ *
+ *   bench baud=400000 actual=396825 test=full n=256 min_us=... median_us=... p99_us=... max_us=... hist=...
+ *
+ * hist counts the samples per power of two bucket, bucket k holding
+ * [2^k, 2^(k+1)) us. 1 MHz is Fast-mode Plus and needs strong pull-ups.
+ */
+
+#define BENCH_SAMPLES       256     /* p99 is the 3rd largest, not max */
+#define BENCH_HIST_BUCKETS  16
+#define BENCH_FPS_MS        1000
+
+SSD1306_DEFINE(display, &ssd1306_transport_default, SSD1306_ADDRESS, SSD1306_COLUMNS, SSD1306_ROWS);
+
+static const uint32_t bench_rates[] = { 100000, 200000, 400000, 600000, 800000, 1000000 };
+
+static uint32_t bench_samples[BENCH_SAMPLES];
+
+static int bench_compare(const void* a, const void* b){
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+/* sorts the samples and prints one result line */
+static void bench_report(uint32_t baud, uint32_t actual, const char* test, const char* unit, uint32_t* samples, int n){
+    uint32_t hist[BENCH_HIST_BUCKETS] = { 0 };
+
+    qsort(samples, n, sizeof(samples[0]), bench_compare);
+    for(int i = 0; i < n; i++){
+        int bucket = 0;
+        while(bucket < BENCH_HIST_BUCKETS - 1 && (samples[i] >> (bucket + 1)))
+            bucket++;
+        hist[bucket]++;
+    }
+
+    printf("bench baud=%lu actual=%lu test=%s n=%d min_%s=%lu median_%s=%lu p99_%s=%lu max_%s=%lu hist=",
+           (unsigned long)baud, (unsigned long)actual, test, n,
+           unit, (unsigned long)samples[0], unit, (unsigned long)samples[n / 2],
+           unit, (unsigned long)samples[(n * 99) / 100], unit, (unsigned long)samples[n - 1]);
+    for(int i = 0; i < BENCH_HIST_BUCKETS; i++)
+        printf(i ? ",%lu" : "%lu", (unsigned long)hist[i]);
+    printf("\n");
+}
+
+/* every page changes, sent as one window */
+static void bench_full(uint32_t baud, uint32_t actual){
+    for(int i = 0; i < BENCH_SAMPLES; i++){
+        ssd1306_fill_vram(&display, i & 1 ? 0xFF : 0x00);
+
+        uint64_t start = time_us_64();
+        ssd1306_refresh(&display);
+        bench_samples[i] = time_us_64() - start;
+    }
+    bench_report(baud, actual, "full", "us", bench_samples, BENCH_SAMPLES);
+}
+
+/* a 16x8 box moving over the panel */
+static void bench_partial(uint32_t baud, uint32_t actual){
+    ssd1306_fill_vram(&display, 0x00);
+    ssd1306_refresh(&display);
+
+    for(int i = 0; i < BENCH_SAMPLES; i++){
+        ssd1306_fill_rect(&display, (i * 16) % SSD1306_COLUMNS, ((i / 8) * 8) % SSD1306_ROWS, 16, 8, SSD1306_INVERT);
+
+        uint64_t start = time_us_64();
+        ssd1306_refresh(&display);
+        bench_samples[i] = time_us_64() - start;
+    }
+    bench_report(baud, actual, "partial", "us", bench_samples, BENCH_SAMPLES);
+}
+
+/* one glyph drawn off the page grid and sent, then the vram side alone */
+static void bench_glyph(uint32_t baud, uint32_t actual){
+    ssd1306_fill_vram(&display, 0x00);
+    ssd1306_refresh(&display);
+
+    for(int i = 0; i < BENCH_SAMPLES; i++){
+        uint64_t start = time_us_64();
+        ssd1306_draw_char(&display, (i * 6) % (SSD1306_COLUMNS - 6), 3, 'A' + i % 26, &ssd1306_font_6x8, SSD1306_INVERT);
+        ssd1306_refresh(&display);
+        bench_samples[i] = time_us_64() - start;
+    }
+    bench_report(baud, actual, "glyph", "us", bench_samples, BENCH_SAMPLES);
+
+    for(int i = 0; i < BENCH_SAMPLES; i++){
+        uint64_t start = time_us_64();
+        ssd1306_draw_string(&display, 0, 3 + i % 5, "The quick brown fox", &ssd1306_font_6x8, SSD1306_INVERT);
+        bench_samples[i] = ((time_us_64() - start) * 1000) / 19;
+    }
+    ssd1306_fill_vram(&display, 0x00);
+    bench_report(baud, actual, "glyph_vram", "ns", bench_samples, BENCH_SAMPLES);
+}
+
+/* full frames back to back through the asynchronous refresh */
+static void bench_fps(uint32_t baud, uint32_t actual){
+    uint32_t frames = 0;
+    uint64_t start = time_us_64();
+    uint64_t end = start + BENCH_FPS_MS * 1000;
+
+    while(time_us_64() < end){
+        ssd1306_fill_vram(&display, frames & 1 ? 0xFF : 0x00);
+        ssd1306_refresh_async(&display, NULL);
+        frames++;
+    }
+    ssd1306_wait(&display);
+
+    uint64_t elapsed = time_us_64() - start;
+    printf("bench baud=%lu actual=%lu test=fps frames=%lu elapsed_us=%llu fps_x100=%llu\n",
+           (unsigned long)baud, (unsigned long)actual, (unsigned long)frames,
+           (unsigned long long)elapsed, (unsigned long long)(frames * 100000000ull / elapsed));
+}
+
+/* grayscale phases back to back, with the planes differing in every byte */
+static void bench_gray(uint32_t baud, uint32_t actual, uint8_t mode, const char* test){
+    static uint8_t planes[SSD1306_GRAY_BYTES(SSD1306_COLUMNS, SSD1306_ROWS)];
+    static ssd1306_gray_t gray;
+    uint32_t steps = 0;
+
+    ssd1306_gray_init(&gray, &display, planes, mode);
+    for(int page = 0; page < SSD1306_PAGES; page++)
+        SSD1306_GRAY_DRAW(&gray, 1 + (page & 1), plane, color,
+                          ssd1306_fill_rect(plane, 0, page * 8, SSD1306_COLUMNS, 8, color));
+
+    uint64_t start = time_us_64();
+    uint64_t end = start + BENCH_FPS_MS * 1000;
+
+    while(time_us_64() < end)
+        steps += ssd1306_gray_step(&gray);
+    ssd1306_wait(&display);
+
+    uint64_t elapsed = time_us_64() - start;
+    printf("bench baud=%lu actual=%lu test=%s steps=%lu elapsed_us=%llu fps_x100=%llu\n",
+           (unsigned long)baud, (unsigned long)actual, test, (unsigned long)steps,
+           (unsigned long long)elapsed, (unsigned long long)(steps * 100000000ull / elapsed));
+
+    /* back to the contrast of ssd1306_init */
+    uint8_t contrast[] = { SSD1306_SETCONTRAST, 0x7F };
+    ssd1306_send_cmdlist(&display, contrast, sizeof(contrast));
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(3000); /* give the host time to open the USB port */
+
+#if !defined(PICO_DEFAULT_I2C_SDA_PIN) || !defined(PICO_DEFAULT_I2C_SCL_PIN)
+#warning oled_bench requires a board with I2C pins
+    puts("Default I2C pins were not defined");
+#else
+    gpio_set_function(PICO_DEFAULT_I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(PICO_DEFAULT_I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(PICO_DEFAULT_I2C_SDA_PIN);
+    gpio_pull_up(PICO_DEFAULT_I2C_SCL_PIN);
+
+    while(1){
+        for(size_t i = 0; i < sizeof(bench_rates) / sizeof(bench_rates[0]); i++){
+            uint32_t baud = bench_rates[i];
+            uint8_t probe[] = { SSD1306_CTRLBYTE_CMD, SSD1306_SETDISPLAY_ON };
+
+            ssd1306_wait(&display);
+            uint32_t actual = i2c_init(i2c0, baud);
+
+            /* the divider rounds the period to the nearest value, either way within 5% is that rate */
+            if(abs((int32_t)(actual - baud)) > baud / 20){
+                printf("bench baud=%lu actual=%lu status=rate_not_achieved\n", (unsigned long)baud, (unsigned long)actual);
+                continue;
+            }
+            if(i2c_write_blocking(i2c0, SSD1306_ADDRESS, probe, sizeof(probe), false) < 0){
+                printf("bench baud=%lu actual=%lu status=nack\n", (unsigned long)baud, (unsigned long)actual);
+                continue;
+            }
+
+            ssd1306_init(&display);
+            bench_full(baud, actual);
+            bench_partial(baud, actual);
+            bench_glyph(baud, actual);
+            bench_fps(baud, actual);
+            bench_gray(baud, actual, SSD1306_GRAY_FRAMES, "gray_frames");
+            bench_gray(baud, actual, SSD1306_GRAY_CONTRAST, "gray_contrast");
+        }
+
+        printf("bench done\n");
+        sleep_ms(10000);
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,651 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+/*
+ * Host regression test of the driver against the SSD1306 emulator. Every
+ * case drives a display through its own emulator instance and checks the
+ * GDDRAM and the bus statistics the emulator decoded. Bus numbers are for a
+ * 128x32 panel at address 0x3C, address and control bytes included. Prints
+ * one line per case and exits non-zero if any check failed:
+ *
+ *   emutest test=splash ok
+ *
+ * Pass a path to keep the PBM dump of the last case.
+ */
+
+static int emutest_failures;
+
+#define EMUTEST_CHECK(test, cond) \
+    do { \
+        if(!(cond)){ \
+            printf("emutest test=%s failed line=%d: %s\n", test, __LINE__, #cond); \
+            emutest_failures++; \
+            return; \
+        } \
+    } while(0)
+
+static ssd1306_emu_t emutest_emu;
+static ssd1306_emu_t emutest_ref;
+static ssd1306_transport_t emutest_transport;
+static ssd1306_transport_t emutest_ref_transport;
+
+SSD1306_DEFINE(emutest_display, &emutest_transport, SSD1306_ADDRESS, 128, 32);
+SSD1306_DEFINE(emutest_ref_64, &emutest_ref_transport, SSD1306_ADDRESS, 128, 64);
+SSD1306_DEFINE_STRIP(emutest_strip_64, &emutest_transport, SSD1306_ADDRESS, 128, 64);
+SSD1306_DEFINE(emutest_absent, &emutest_transport, SSD1306_ADDRESS + 1, 128, 32);
+
+/* fresh emulator behind emutest_transport, statistics cleared */
+static void emutest_reset(void){
+    ssd1306_emu_reset(&emutest_emu, SSD1306_ADDRESS, 400000);
+    emutest_transport = ssd1306_emu_transport(&emutest_emu);
+}
+
+static bool emutest_gddram_equals(const ssd1306_emu_t* emu, const uint8_t* vram, int pages){
+    for(int page = 0; page < pages; page++)
+        if(memcmp(emu->gddram[page], &vram[page * SSD1306_EMU_COLUMNS], SSD1306_EMU_COLUMNS))
+            return false;
+    return true;
+}
+
+/* every transaction put on the bus since emutest_log_start, control bytes included, address left out */
+static struct {
+    uint8_t bytes[2048];
+    size_t  lenght;
+    size_t  ends[64];               /* end of each transaction in bytes */
+    size_t  count;
+} emutest_log;
+
+static void emutest_log_byte(uint8_t byte){
+    if(emutest_log.lenght < sizeof(emutest_log.bytes))
+        emutest_log.bytes[emutest_log.lenght++] = byte;
+}
+
+static void emutest_log_end(void){
+    if(emutest_log.count < sizeof(emutest_log.ends) / sizeof(emutest_log.ends[0]))
+        emutest_log.ends[emutest_log.count++] = emutest_log.lenght;
+}
+
+static int emutest_log_write(void* context, uint8_t address, const ssd1306_segment_t* segments, size_t count){
+    for(size_t i = 0; i < count; i++)
+        for(size_t j = 0; j < segments[i].lenght; j++)
+            emutest_log_byte(segments[i].data[j]);
+    emutest_log_end();
+
+    return ssd1306_emu_transport(&emutest_emu).write(context, address, segments, count);
+}
+
+static void emutest_log_write_stream(void* context, uint8_t address, const uint16_t* stream, size_t count,
+                                     ssd1306_done_t done, void* arg){
+    for(size_t i = 0; i < count; i++){
+        emutest_log_byte(stream[i] & 0xFF);
+        if(stream[i] & SSD1306_STREAM_STOP)
+            emutest_log_end();
+    }
+
+    ssd1306_emu_transport(&emutest_emu).write_stream(context, address, stream, count, done, arg);
+}
+
+/* logs everything that goes through emutest_transport from here on */
+static void emutest_log_start(void){
+    memset(&emutest_log, 0, sizeof(emutest_log));
+    emutest_transport.write = emutest_log_write;
+    emutest_transport.write_stream = emutest_log_write_stream;
+}
+
+/* transaction tx of the log is exactly the given bytes */
+static bool emutest_log_equals(size_t tx, const uint8_t* bytes, size_t lenght){
+    size_t start = tx ? emutest_log.ends[tx - 1] : 0;
+
+    return tx < emutest_log.count && emutest_log.ends[tx] - start == lenght &&
+           !memcmp(&emutest_log.bytes[start], bytes, lenght);
+}
+
+#define EMUTEST_TX(tx, ...) \
+    emutest_log_equals(tx, (const uint8_t[]){ __VA_ARGS__ }, sizeof((const uint8_t[]){ __VA_ARGS__ }))
+
+/* display state seen at the end of the first transaction */
+static int emutest_first_on;
+
+static int emutest_spy_write(void* context, uint8_t address, const ssd1306_segment_t* segments, size_t count){
+    int ret = ssd1306_emu_transport(&emutest_emu).write(context, address, segments, count);
+
+    if(emutest_first_on < 0)
+        emutest_first_on = emutest_emu.display_on;
+    return ret;
+}
+
+/* init list and splash in one transaction, display on only once the splash is in GDDRAM */
+static void emutest_splash(void){
+    static uint8_t splash[128 * 4];
+
+    for(size_t i = 0; i < sizeof(splash); i++)
+        splash[i] = i * 7;
+
+    emutest_reset();
+    emutest_transport.write = emutest_spy_write;
+    emutest_first_on = -1;
+
+    EMUTEST_CHECK("splash", ssd1306_init_splash(&emutest_display, splash) == 577);
+    EMUTEST_CHECK("splash", emutest_emu.transactions == 2);
+    EMUTEST_CHECK("splash", emutest_emu.bytes == 579);
+    EMUTEST_CHECK("splash", emutest_first_on == 0);
+    EMUTEST_CHECK("splash", emutest_emu.display_on);
+    EMUTEST_CHECK("splash", emutest_gddram_equals(&emutest_emu, splash, 4));
+    EMUTEST_CHECK("splash", !memcmp(emutest_display.vram, splash, sizeof(splash)));
+
+    printf("emutest test=splash ok\n");
+}
+
+/* full and dirty refreshes land in GDDRAM */
+static void emutest_refresh(void){
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_fill_vram(&emutest_display, 0x00);
+    ssd1306_draw_string(&emutest_display, 3, 5, "refresh", &ssd1306_font_6x8, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("refresh", emutest_gddram_equals(&emutest_emu, emutest_display.vram, 4));
+
+    ssd1306_draw_pixel(&emutest_display, 100, 30, SSD1306_WHITE);
+    ssd1306_refresh_async(&emutest_display, NULL);
+    EMUTEST_CHECK("refresh", ssd1306_wait(&emutest_display) == 0);
+    EMUTEST_CHECK("refresh", emutest_gddram_equals(&emutest_emu, emutest_display.vram, 4));
+
+    printf("emutest test=refresh ok\n");
+}
+
+/*
+ * The refresh planner sends dirty regions as windows of their own, or merges
+ * them when SSD1306_WINDOW_OVERHEAD makes that cheaper. Byte by byte, blocking
+ * and asynchronous refreshes put the same transactions on the bus.
+ */
+static void emutest_planner(void){
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_fill_vram(&emutest_display, 0x00);
+    ssd1306_refresh(&emutest_display);
+
+    /* a clean frame sends nothing */
+    emutest_log_start();
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("planner", emutest_log.count == 0);
+
+    /* one pixel is a one byte window */
+    ssd1306_draw_pixel(&emutest_display, 100, 30, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("planner", emutest_log.count == 2);
+    EMUTEST_CHECK("planner", EMUTEST_TX(0, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 3, 3, SSD1306_SETCOLRANGE, 100, 100));
+    EMUTEST_CHECK("planner", EMUTEST_TX(1, SSD1306_CTRLBYTE_DATA, 0x40));
+
+    /* the same column on pages 0 and 3: one 4 byte window beats two 1 byte ones */
+    emutest_log_start();
+    ssd1306_draw_pixel(&emutest_display, 10, 0, SSD1306_WHITE);
+    ssd1306_draw_pixel(&emutest_display, 10, 31, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("planner", emutest_log.count == 2);
+    EMUTEST_CHECK("planner", EMUTEST_TX(0, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 0, 3, SSD1306_SETCOLRANGE, 10, 10));
+    EMUTEST_CHECK("planner", EMUTEST_TX(1, SSD1306_CTRLBYTE_DATA, 0x01, 0x00, 0x00, 0x80));
+
+    /* far apart columns on neighbouring pages stay two windows, sent bottom up */
+    emutest_log_start();
+    ssd1306_fill_rect(&emutest_display, 0, 0, 2, 8, SSD1306_WHITE);
+    ssd1306_fill_rect(&emutest_display, 120, 8, 2, 8, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("planner", emutest_log.count == 4);
+    EMUTEST_CHECK("planner", EMUTEST_TX(0, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 1, 1, SSD1306_SETCOLRANGE, 120, 121));
+    EMUTEST_CHECK("planner", EMUTEST_TX(1, SSD1306_CTRLBYTE_DATA, 0xFF, 0xFF));
+    EMUTEST_CHECK("planner", EMUTEST_TX(2, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 0, 0, SSD1306_SETCOLRANGE, 0, 1));
+    EMUTEST_CHECK("planner", EMUTEST_TX(3, SSD1306_CTRLBYTE_DATA, 0xFF, 0xFF));
+
+    /* the asynchronous path streams the same transactions */
+    emutest_log_start();
+    ssd1306_fill_rect(&emutest_display, 0, 0, 2, 8, SSD1306_BLACK);
+    ssd1306_fill_rect(&emutest_display, 120, 8, 2, 8, SSD1306_BLACK);
+    ssd1306_refresh_async(&emutest_display, NULL);
+    EMUTEST_CHECK("planner", ssd1306_wait(&emutest_display) == 0);
+    EMUTEST_CHECK("planner", emutest_log.count == 4);
+    EMUTEST_CHECK("planner", EMUTEST_TX(0, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 1, 1, SSD1306_SETCOLRANGE, 120, 121));
+    EMUTEST_CHECK("planner", EMUTEST_TX(1, SSD1306_CTRLBYTE_DATA, 0x00, 0x00));
+    EMUTEST_CHECK("planner", EMUTEST_TX(2, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 0, 0, SSD1306_SETCOLRANGE, 0, 1));
+    EMUTEST_CHECK("planner", EMUTEST_TX(3, SSD1306_CTRLBYTE_DATA, 0x00, 0x00));
+    EMUTEST_CHECK("planner", emutest_gddram_equals(&emutest_emu, emutest_display.vram, 4));
+
+    printf("emutest test=planner ok\n");
+}
+
+/*
+ * Batch encoder: a short run is rewritten into Co control byte pairs so the
+ * batch stays one transaction, a long one ends its transaction instead, and
+ * data that overflows the buffer carries on in the next one.
+ */
+static void emutest_batch(void){
+    static const uint8_t cfg[] = { SSD1306_SETPAGERANGE, 1, 1, SSD1306_SETCOLRANGE, 8, 13 };
+    static uint8_t data[300];
+
+    for(size_t i = 0; i < sizeof(data); i++)
+        data[i] = i;
+
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+
+    emutest_log_start();
+    ssd1306_batch_begin(&emutest_display);
+    ssd1306_send_cmdlist(&emutest_display, cfg, sizeof(cfg));
+    ssd1306_send_data(&emutest_display, data, 6);
+    EMUTEST_CHECK("batch", emutest_log.count == 0);
+    EMUTEST_CHECK("batch", ssd1306_batch_end(&emutest_display) == 0);
+    EMUTEST_CHECK("batch", emutest_log.count == 1);
+    EMUTEST_CHECK("batch", EMUTEST_TX(0, 0x80, SSD1306_SETPAGERANGE, 0x80, 1, 0x80, 1,
+                                         0x80, SSD1306_SETCOLRANGE, 0x80, 8, 0x80, 13,
+                                         SSD1306_CTRLBYTE_DATA, 0, 1, 2, 3, 4, 5));
+    EMUTEST_CHECK("batch", !memcmp(&emutest_emu.gddram[1][8], data, 6));
+
+    /* data past SSD1306_BATCH_PAIR_MAX is flushed before the next command */
+    emutest_log_start();
+    ssd1306_batch_begin(&emutest_display);
+    ssd1306_send_data(&emutest_display, data, 10);
+    ssd1306_send_cmdlist(&emutest_display, cfg, 3);
+    ssd1306_batch_end(&emutest_display);
+    EMUTEST_CHECK("batch", emutest_log.count == 2);
+    EMUTEST_CHECK("batch", EMUTEST_TX(0, SSD1306_CTRLBYTE_DATA, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+    EMUTEST_CHECK("batch", EMUTEST_TX(1, SSD1306_CTRLBYTE_CMD, SSD1306_SETPAGERANGE, 1, 1));
+
+    /* a full buffer is one control byte and 255 data bytes */
+    emutest_log_start();
+    ssd1306_batch_begin(&emutest_display);
+    ssd1306_send_data(&emutest_display, data, sizeof(data));
+    ssd1306_batch_end(&emutest_display);
+    EMUTEST_CHECK("batch", emutest_log.count == 2);
+    EMUTEST_CHECK("batch", emutest_log.ends[0] == SSD1306_BATCH_SIZE);
+    EMUTEST_CHECK("batch", emutest_log.ends[1] == sizeof(data) + 2);
+    EMUTEST_CHECK("batch", emutest_log.bytes[SSD1306_BATCH_SIZE] == SSD1306_CTRLBYTE_DATA);
+    EMUTEST_CHECK("batch", emutest_log.bytes[SSD1306_BATCH_SIZE + 1] == data[SSD1306_BATCH_SIZE - 1]);
+
+    /* a NACK shows up in the return of the batch and of every blocking path */
+    ssd1306_batch_begin(&emutest_absent);
+    ssd1306_send_data(&emutest_absent, data, sizeof(data));
+    EMUTEST_CHECK("batch", ssd1306_batch_end(&emutest_absent) < 0);
+    EMUTEST_CHECK("batch", ssd1306_init(&emutest_absent) < 0);
+    EMUTEST_CHECK("batch", ssd1306_refresh(&emutest_absent) < 0);
+    EMUTEST_CHECK("batch", ssd1306_send_cmdlist(&emutest_absent, cfg, sizeof(cfg)) < 0);
+
+    /* and is not carried into the next batch */
+    ssd1306_batch_begin(&emutest_display);
+    ssd1306_send_data(&emutest_display, data, 6);
+    EMUTEST_CHECK("batch", ssd1306_batch_end(&emutest_display) == 0);
+
+    printf("emutest test=batch ok\n");
+}
+
+/* expected panel for the pixel output cases, one byte per pixel */
+static uint8_t emutest_expect[32][128];
+
+static void emutest_expect_pixel(int x, int y, uint8_t color){
+    if(x < 0 || x >= 128 || y < 0 || y >= 32)
+        return;
+    emutest_expect[y][x] = color == SSD1306_INVERT ? !emutest_expect[y][x] : color;
+}
+
+static void emutest_expect_rect(int x, int y, int w, int h, uint8_t color){
+    for(int j = y; j < y + h; j++)
+        for(int i = x; i < x + w; i++)
+            emutest_expect_pixel(i, j, color);
+}
+
+/* refreshes and compares every panel pixel with emutest_expect */
+static bool emutest_panel_matches(void){
+    ssd1306_refresh(&emutest_display);
+    for(int y = 0; y < 32; y++)
+        for(int x = 0; x < 128; x++)
+            if(ssd1306_emu_pixel(&emutest_emu, x, y) != emutest_expect[y][x])
+                return false;
+    return true;
+}
+
+/* span fills land on the right pixels across page boundaries, clipped at the edges */
+static void emutest_primitives(void){
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_fill_vram(&emutest_display, 0x00);
+    memset(emutest_expect, 0, sizeof(emutest_expect));
+
+    ssd1306_fill_rect(&emutest_display, 5, 3, 50, 20, SSD1306_WHITE);
+    emutest_expect_rect(5, 3, 50, 20, SSD1306_WHITE);
+    ssd1306_fill_rect(&emutest_display, 20, 10, 30, 4, SSD1306_INVERT);
+    emutest_expect_rect(20, 10, 30, 4, SSD1306_INVERT);
+    ssd1306_fill_rect(&emutest_display, 40, 0, 10, 32, SSD1306_BLACK);
+    emutest_expect_rect(40, 0, 10, 32, SSD1306_BLACK);
+    EMUTEST_CHECK("primitives", emutest_panel_matches());
+
+    ssd1306_draw_hline(&emutest_display, -5, 25, 200, SSD1306_WHITE);
+    emutest_expect_rect(-5, 25, 200, 1, SSD1306_WHITE);
+    ssd1306_draw_vline(&emutest_display, 127, -4, 10, SSD1306_WHITE);
+    emutest_expect_rect(127, -4, 1, 10, SSD1306_WHITE);
+    ssd1306_draw_vline(&emutest_display, 70, 6, 19, SSD1306_INVERT);
+    emutest_expect_rect(70, 6, 1, 19, SSD1306_INVERT);
+    ssd1306_fill_rect(&emutest_display, 120, 28, 20, 20, SSD1306_INVERT);
+    emutest_expect_rect(120, 28, 20, 20, SSD1306_INVERT);
+    EMUTEST_CHECK("primitives", emutest_panel_matches());
+
+    ssd1306_draw_rect(&emutest_display, 80, 2, 20, 13, SSD1306_INVERT);
+    emutest_expect_rect(80, 2, 20, 1, SSD1306_INVERT);
+    emutest_expect_rect(80, 14, 20, 1, SSD1306_INVERT);
+    emutest_expect_rect(80, 3, 1, 11, SSD1306_INVERT);
+    emutest_expect_rect(99, 3, 1, 11, SSD1306_INVERT);
+    ssd1306_draw_pixel(&emutest_display, 90, 8, SSD1306_WHITE);
+    emutest_expect_pixel(90, 8, SSD1306_WHITE);
+    ssd1306_draw_pixel(&emutest_display, 200, 8, SSD1306_WHITE);
+    ssd1306_draw_pixel(&emutest_display, 90, 40, SSD1306_WHITE);
+    EMUTEST_CHECK("primitives", emutest_panel_matches());
+
+    printf("emutest test=primitives ok\n");
+}
+
+static void emutest_expect_glyph(int x, int y, char c, const ssd1306_font_t* font, uint8_t color){
+    const uint8_t* glyph = &font->glyphs[(c - font->first) * font->width * font->pages];
+
+    for(int col = 0; col < font->width; col++)
+        for(int row = 0; row < 8 * font->pages; row++)
+            if((glyph[col * font->pages + row / 8] >> (row % 8)) & 1)
+                emutest_expect_pixel(x + col, y + row, color);
+}
+
+/*
+ * Glyphs come out as in the font table at every row offset, through the
+ * pre-shifted cache and around it, clipped at the panel edges. Drawing the
+ * same glyph twice with SSD1306_INVERT takes it from the cache and cancels out.
+ */
+static void emutest_glyphs(void){
+    static const ssd1306_font_t* const fonts[] = { &ssd1306_font_6x8, &ssd1306_font_12x16, &ssd1306_font_18x24 };
+
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+
+    for(size_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++){
+        const ssd1306_font_t* font = fonts[f];
+
+        for(int shift = 0; shift < 8; shift++){
+            int x = 3 * shift - 2, y = shift + (font->pages == 1 ? 8 : 0);
+
+            ssd1306_fill_vram(&emutest_display, 0x00);
+            memset(emutest_expect, 0, sizeof(emutest_expect));
+            ssd1306_draw_string(&emutest_display, 127 - font->width, 28, "W", font, SSD1306_WHITE);
+            emutest_expect_glyph(127 - font->width, 28, 'W', font, SSD1306_WHITE);
+            for(const char* c = "Ag"; *c; c++, x += font->width){
+                ssd1306_draw_char(&emutest_display, x, y, *c, font, SSD1306_WHITE);
+                emutest_expect_glyph(x, y, *c, font, SSD1306_WHITE);
+            }
+            EMUTEST_CHECK("glyphs", emutest_panel_matches());
+
+            ssd1306_draw_char(&emutest_display, 60, y, '#', font, SSD1306_INVERT);
+            ssd1306_draw_char(&emutest_display, 60, y, '#', font, SSD1306_INVERT);
+            EMUTEST_CHECK("glyphs", emutest_panel_matches());
+        }
+    }
+
+    printf("emutest test=glyphs ok\n");
+}
+
+/* streamed bitmaps go straight to GDDRAM, masked ones are refused, NACKs are reported */
+static void emutest_stream_bitmap(void){
+    static const uint8_t data[] = { 0x07, 1, 2, 3, 4, 5, 6, 7, 8, 0x84, 0xAA };
+    static const uint8_t mask[] = { 0x8C, 0xFF, 0x80, 0x0F };
+    ssd1306_bitmap_t bitmap = { .data = data, .width = 7, .pages = 2 };
+
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_refresh(&emutest_display);
+
+    EMUTEST_CHECK("stream_bitmap", ssd1306_stream_bitmap(&emutest_display, 10, 1, &bitmap) == 0);
+    EMUTEST_CHECK("stream_bitmap", !memcmp(&emutest_emu.gddram[1][10], (const uint8_t[]){ 1, 2, 3, 4, 5, 6, 7 }, 7));
+    EMUTEST_CHECK("stream_bitmap", !memcmp(&emutest_emu.gddram[2][10], (const uint8_t[]){ 8, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA }, 7));
+    EMUTEST_CHECK("stream_bitmap", emutest_display.vram[1 * 128 + 10] == 0x00);
+
+    EMUTEST_CHECK("stream_bitmap", ssd1306_stream_bitmap(&emutest_absent, 10, 1, &bitmap) < 0);
+
+    bitmap.mask = mask;
+    emutest_log_start();
+    EMUTEST_CHECK("stream_bitmap", ssd1306_stream_bitmap(&emutest_display, 10, 1, &bitmap) == -1);
+    EMUTEST_CHECK("stream_bitmap", emutest_log.count == 0);
+
+    printf("emutest test=stream_bitmap ok\n");
+}
+
+/* several displays refresh in one call, the first error comes back */
+static void emutest_displays(void){
+    ssd1306_t* displays[] = { &emutest_display, &emutest_ref_64, &emutest_absent };
+
+    emutest_reset();
+    ssd1306_emu_reset(&emutest_ref, SSD1306_ADDRESS, 400000);
+    emutest_ref_transport = ssd1306_emu_transport(&emutest_ref);
+    ssd1306_init(&emutest_display);
+    ssd1306_init(&emutest_ref_64);
+    ssd1306_fill_rect(&emutest_display, 0, 0, 16, 16, SSD1306_WHITE);
+    ssd1306_fill_rect(&emutest_ref_64, 0, 40, 16, 16, SSD1306_WHITE);
+
+    EMUTEST_CHECK("displays", ssd1306_refresh_displays(displays, 2) == 0);
+    EMUTEST_CHECK("displays", emutest_gddram_equals(&emutest_emu, emutest_display.vram, 4));
+    EMUTEST_CHECK("displays", emutest_gddram_equals(&emutest_ref, emutest_ref_64.vram, 8));
+
+    ssd1306_fill_vram(&emutest_display, 0xFF);
+    ssd1306_fill_vram(&emutest_absent, 0xFF);
+    EMUTEST_CHECK("displays", ssd1306_refresh_displays(displays, 3) < 0);
+    EMUTEST_CHECK("displays", emutest_gddram_equals(&emutest_emu, emutest_display.vram, 4));
+
+    EMUTEST_CHECK("displays", ssd1306_refresh_displays(displays, 0) == 0);
+    EMUTEST_CHECK("displays", ssd1306_refresh_displays(displays, SSD1306_DISPLAYS_MAX + 1) == -1);
+
+    printf("emutest test=displays ok\n");
+}
+
+/* vram x runs left to right on the panel, text reads the right way round */
+static void emutest_orientation(void){
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_fill_vram(&emutest_display, 0x00);
+    ssd1306_draw_string(&emutest_display, 0, 0, "FL", &ssd1306_font_6x8, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+
+    /* F: stem in column 1, top bar out to column 5; L: stem in column 7 */
+    EMUTEST_CHECK("orientation", ssd1306_emu_pixel(&emutest_emu, 1, 5));
+    EMUTEST_CHECK("orientation", ssd1306_emu_pixel(&emutest_emu, 5, 0));
+    EMUTEST_CHECK("orientation", !ssd1306_emu_pixel(&emutest_emu, 5, 6));
+    EMUTEST_CHECK("orientation", ssd1306_emu_pixel(&emutest_emu, 7, 5));
+    EMUTEST_CHECK("orientation", !ssd1306_emu_pixel(&emutest_emu, 126, 5));
+
+    printf("emutest test=orientation ok\n");
+}
+
+/* one character after the console is set up is a single 20 byte transaction */
+static void emutest_console(void){
+    static ssd1306_console_t con;
+    char line[16];
+
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_refresh(&emutest_display);
+    ssd1306_console_init(&con, &emutest_display);
+    for(int i = 0; i < 10; i++){
+        int lenght = snprintf(line, sizeof(line), "line %d\n", i);
+        ssd1306_console_write(&con, line, lenght);
+        ssd1306_console_flush(&con);
+    }
+
+    ssd1306_emu_reset_stats(&emutest_emu);
+    ssd1306_console_write(&con, "x", 1);
+    ssd1306_console_flush(&con);
+    EMUTEST_CHECK("console", emutest_emu.transactions == 1);
+    EMUTEST_CHECK("console", emutest_emu.bytes == 20);
+
+    /* an unchanged grid sends nothing */
+    ssd1306_emu_reset_stats(&emutest_emu);
+    ssd1306_console_flush(&con);
+    EMUTEST_CHECK("console", emutest_emu.transactions == 0);
+
+    printf("emutest test=console ok\n");
+}
+
+/* both grayscale cycles average to 0, 1/3, 2/3 and full brightness */
+static void emutest_gray(void){
+    static uint8_t planes[SSD1306_GRAY_BYTES(128, 32)];
+    static ssd1306_gray_t gray;
+
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+
+    for(uint8_t mode = SSD1306_GRAY_FRAMES; mode <= SSD1306_GRAY_CONTRAST; mode++){
+        int phases = mode == SSD1306_GRAY_CONTRAST ? 2 : 3;
+        uint32_t weight[4] = { 0 };
+
+        ssd1306_fill_vram(&emutest_display, 0x00);
+        ssd1306_refresh(&emutest_display);
+        ssd1306_gray_init(&gray, &emutest_display, planes, mode);
+        for(int level = 0; level < 4; level++)
+            SSD1306_GRAY_DRAW(&gray, level, plane, color, ssd1306_fill_rect(plane, level * 32, 0, 32, 32, color));
+
+        /* a pixel counts with the contrast it is shown at */
+        for(int step = 0; step < 4 * phases; step++){
+            EMUTEST_CHECK("gray", ssd1306_gray_step(&gray));
+            EMUTEST_CHECK("gray", ssd1306_wait(&emutest_display) == 0);
+            for(int level = 0; level < 4; level++)
+                if(emutest_emu.gddram[0][level * 32 + 16] == 0xFF)
+                    weight[level] += mode == SSD1306_GRAY_CONTRAST ? emutest_emu.contrast : 1;
+        }
+
+        EMUTEST_CHECK("gray", weight[0] == 0);
+        for(int level = 1; level < 3; level++)
+            EMUTEST_CHECK("gray", abs((int)(3 * weight[level]) - (int)(level * weight[3])) <= 3 * 4);
+        if(mode == SSD1306_GRAY_FRAMES)
+            EMUTEST_CHECK("gray", weight[3] == 4 * 3);
+    }
+
+    printf("emutest test=gray ok\n");
+}
+
+/* the display list on a one page strip ends up as the same GDDRAM as drawing the frame */
+static void emutest_list(void){
+    static ssd1306_op_t ops[16];
+    static ssd1306_list_t list;
+
+    emutest_reset();
+    ssd1306_emu_reset(&emutest_ref, SSD1306_ADDRESS, 400000);
+    emutest_ref_transport = ssd1306_emu_transport(&emutest_ref);
+    ssd1306_init(&emutest_strip_64);
+    ssd1306_init(&emutest_ref_64);
+
+    ssd1306_list_init(&list, ops, 16);
+    ssd1306_list_string(&list, 3, 5, "Strip render", &ssd1306_font_6x8, SSD1306_WHITE);
+    ssd1306_list_circle(&list, 100, 40, 20, SSD1306_WHITE);
+    ssd1306_list_fill_circle(&list, 100, 40, 8, SSD1306_INVERT);
+    ssd1306_list_line(&list, 0, 63, 127, 0, SSD1306_INVERT);
+    ssd1306_list_rect(&list, 0, 0, 128, 64, SSD1306_WHITE);
+    ssd1306_list_render(&emutest_strip_64, &list);
+    EMUTEST_CHECK("list", ssd1306_wait(&emutest_strip_64) == 0);
+
+    ssd1306_fill_vram(&emutest_ref_64, 0x00);
+    ssd1306_draw_string(&emutest_ref_64, 3, 5, "Strip render", &ssd1306_font_6x8, SSD1306_WHITE);
+    ssd1306_draw_circle(&emutest_ref_64, 100, 40, 20, SSD1306_WHITE);
+    ssd1306_fill_circle(&emutest_ref_64, 100, 40, 8, SSD1306_INVERT);
+    ssd1306_draw_line(&emutest_ref_64, 0, 63, 127, 0, SSD1306_INVERT);
+    ssd1306_draw_rect(&emutest_ref_64, 0, 0, 128, 64, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_ref_64);
+
+    EMUTEST_CHECK("list", !memcmp(emutest_emu.gddram, emutest_ref.gddram, sizeof(emutest_emu.gddram)));
+
+    printf("emutest test=list ok\n");
+}
+
+/* no GDDRAM writes while the panel scrolls, the dirty range goes out after the stop */
+static void emutest_scroll(void){
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_fill_vram(&emutest_display, 0x00);
+    ssd1306_refresh(&emutest_display);
+
+    ssd1306_scroll_setup(&emutest_display, SSD1306_SCROLL_SETUP_H_LEFT, 0, 1, SSD1306_SCROLL_FRAMES_2, 0);
+    ssd1306_scroll_start(&emutest_display);
+    ssd1306_emu_reset_stats(&emutest_emu);
+
+    ssd1306_fill_rect(&emutest_display, 0, 24, 10, 8, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+    ssd1306_refresh_async(&emutest_display, NULL);
+    ssd1306_wait(&emutest_display);
+    EMUTEST_CHECK("scroll", emutest_emu.data_bytes == 0);
+
+    ssd1306_scroll_stop(&emutest_display);
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("scroll", emutest_emu.data_bytes > 0);
+    EMUTEST_CHECK("scroll", emutest_emu.gddram[3][5] == 0xFF);
+
+    printf("emutest test=scroll ok\n");
+}
+
+/* a NACKed stream shows up in the wait status */
+static void emutest_nack(void){
+    emutest_reset();
+    ssd1306_fill_vram(&emutest_absent, 0xFF);
+    ssd1306_refresh_async(&emutest_absent, NULL);
+    EMUTEST_CHECK("nack", ssd1306_wait(&emutest_absent) < 0);
+    EMUTEST_CHECK("nack", emutest_emu.data_bytes == 0);
+
+    /* reported once, the next wait is clean */
+    EMUTEST_CHECK("nack", ssd1306_wait(&emutest_absent) == 0);
+    EMUTEST_CHECK("nack", ssd1306_probe(&emutest_absent) < 0);
+
+    printf("emutest test=nack ok\n");
+}
+
+/* the PBM dump is the panel view, which matches vram with the default init list */
+static void emutest_pbm(const char* path){
+    char header[64];
+    uint8_t row[SSD1306_EMU_COLUMNS / 8];
+    int width, height;
+    FILE* file;
+
+    emutest_reset();
+    ssd1306_init(&emutest_display);
+    ssd1306_fill_vram(&emutest_display, 0x00);
+    ssd1306_draw_pixel(&emutest_display, 0, 0, SSD1306_WHITE);
+    ssd1306_refresh(&emutest_display);
+    EMUTEST_CHECK("pbm", ssd1306_emu_write_pbm(&emutest_emu, path) == 0);
+
+    file = fopen(path, "rb");
+    EMUTEST_CHECK("pbm", file);
+    EMUTEST_CHECK("pbm", fgets(header, sizeof(header), file) && !strcmp(header, "P4\n"));
+    EMUTEST_CHECK("pbm", fscanf(file, "%d %d", &width, &height) == 2 && fgetc(file) == '\n');
+    EMUTEST_CHECK("pbm", width == 128 && height == 32);
+    EMUTEST_CHECK("pbm", fread(row, 1, sizeof(row), file) == sizeof(row));
+    fclose(file);
+
+    /* vram column 0 is the leftmost panel pixel */
+    EMUTEST_CHECK("pbm", row[0] == 0x80 && row[sizeof(row) - 1] == 0x00);
+
+    printf("emutest test=pbm ok\n");
+}
+
+int main(int argc, char** argv){
+    const char* pbm = argc > 1 ? argv[1] : "oled_emu_test.pbm";
+
+    emutest_splash();
+    emutest_refresh();
+    emutest_planner();
+    emutest_batch();
+    emutest_primitives();
+    emutest_glyphs();
+    emutest_stream_bitmap();
+    emutest_displays();
+    emutest_orientation();
+    emutest_console();
+    emutest_gray();
+    emutest_list();
+    emutest_scroll();
+    emutest_nack();
+    emutest_pbm(pbm);
+    if(argc <= 1)
+        remove(pbm);
+
+    printf("emutest failures=%d\n", emutest_failures);
+    return emutest_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+
+/*
+ * Host microbenchmark of the drawing and encoding kernels. The displays sit
+ * on a null transport that only counts bytes, so the numbers are CPU time
+ * alone. One line per kernel and panel geometry:
+ *
+ *   microbench geometry=128x32 test=glyph n=200000 ns_op=... bytes_op=...
+ *
+ * bytes_op is what the kernel hands to the bus per call, control bytes
+ * included. Pass an iteration count to override the default.
+ */
+
+#define MICROBENCH_ITERATIONS   200000
+#define MICROBENCH_POINTS       1024
+
+/* transport that drops every byte, completes streams right away */
+static uint64_t microbench_bytes;
+
+static int microbench_write(void* context, uint8_t address, const ssd1306_segment_t* segments, size_t count){
+    size_t lenght = 0;
+
+    (void)context;
+    (void)address;
+
+    for(size_t i = 0; i < count; i++)
+        lenght += segments[i].lenght;
+    microbench_bytes += lenght;
+    return lenght;
+}
+
+static void microbench_write_stream(void* context, uint8_t address, const uint16_t* stream, size_t count,
+                                    ssd1306_done_t done, void* arg){
+    (void)context;
+    (void)address;
+    (void)stream;
+    microbench_bytes += count;
+    done(arg);
+}
+
+static bool microbench_busy(void* context){
+    (void)context;
+    return false;
+}
+
+static int microbench_wait(void* context){
+    (void)context;
+    return 0;
+}
+
+static ssd1306_transport_t microbench_transport = {
+    .write = microbench_write,
+    .write_stream = microbench_write_stream,
+    .busy = microbench_busy,
+    .wait = microbench_wait,
+};
+
+SSD1306_DEFINE(display_128x32, &microbench_transport, SSD1306_ADDRESS, 128, 32);
+SSD1306_DEFINE(display_128x64, &microbench_transport, SSD1306_ADDRESS, 128, 64);
+SSD1306_DEFINE(display_96x16, &microbench_transport, SSD1306_ADDRESS, 96, 16);
+SSD1306_DEFINE(display_64x48, &microbench_transport, SSD1306_ADDRESS, 64, 48);
+
+static ssd1306_t* const microbench_displays[] = { &display_128x32, &display_128x64, &display_96x16, &display_64x48 };
+
+static int16_t microbench_x[MICROBENCH_POINTS];
+static int16_t microbench_y[MICROBENCH_POINTS];
+
+static uint64_t microbench_ns(void){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+typedef void (*microbench_kernel_t)(ssd1306_t* disp, uint32_t i);
+
+/* every page changes */
+static void microbench_fill(ssd1306_t* disp, uint32_t i){
+    ssd1306_fill_vram(disp, i & 1 ? 0xFF : 0x00);
+}
+
+static void microbench_pixel(ssd1306_t* disp, uint32_t i){
+    uint32_t k = i % MICROBENCH_POINTS;
+    ssd1306_draw_pixel(disp, microbench_x[k] % disp->width, microbench_y[k] % disp->height, SSD1306_INVERT);
+}
+
+/* odd rows are off the page grid, so every glyph straddles two pages */
+static void microbench_glyph(ssd1306_t* disp, uint32_t i){
+    uint32_t k = i % MICROBENCH_POINTS;
+    ssd1306_draw_char(disp, microbench_x[k] % (disp->width - 6), (microbench_y[k] % (disp->height - 8)) | 1,
+                      'A' + i % 26, &ssd1306_font_6x8, SSD1306_INVERT);
+}
+
+static void microbench_string(ssd1306_t* disp, uint32_t i){
+    ssd1306_draw_string(disp, 0, 3 + i % 5, "The quick brown fox", &ssd1306_font_6x8_prop, SSD1306_INVERT);
+}
+
+/* a few scattered pixels, then the refresh plan and the stream for them */
+static void microbench_dirty(ssd1306_t* disp, uint32_t i){
+    for(uint32_t k = i; k < i + 4; k++)
+        ssd1306_draw_pixel(disp, microbench_x[k % MICROBENCH_POINTS] % disp->width,
+                           microbench_y[k % MICROBENCH_POINTS] % disp->height, SSD1306_INVERT);
+    ssd1306_refresh_async(disp, NULL);
+}
+
+/* whole frame into the asynchronous word stream */
+static void microbench_encode(ssd1306_t* disp, uint32_t i){
+    (void)i;
+    ssd1306_mark_dirty(disp, 0, disp->width - 1, 0, disp->pages - 1);
+    ssd1306_refresh_async(disp, NULL);
+}
+
+/* whole frame through the gathered blocking writes */
+static void microbench_refresh(ssd1306_t* disp, uint32_t i){
+    (void)i;
+    ssd1306_mark_dirty(disp, 0, disp->width - 1, 0, disp->pages - 1);
+    ssd1306_refresh(disp);
+}
+
+/* one glyph sized window per call through the batch encoder */
+static void microbench_batch(ssd1306_t* disp, uint32_t i){
+    uint8_t col = (i * 6) % (disp->width - 6);
+    uint8_t cfg[] = {
+        SSD1306_SETPAGERANGE, 0, 0,
+        SSD1306_SETCOLRANGE, col, col + 5
+    };
+
+    ssd1306_batch_begin(disp);
+    ssd1306_send_cmdlist(disp, cfg, sizeof(cfg));
+    ssd1306_send_data(disp, ssd1306_font6x8[i % 96], 6);
+    ssd1306_batch_end(disp);
+}
+
+/* one grayscale phase per call, with the planes differing in every byte */
+static void microbench_gray(ssd1306_t* disp, uint32_t i){
+    static uint8_t planes[SSD1306_GRAY_BYTES(SSD1306_COLUMNS, 64)];
+    static ssd1306_gray_t gray;
+
+    if(i == 0){
+        ssd1306_gray_init(&gray, disp, planes, SSD1306_GRAY_CONTRAST);
+        for(int page = 0; page < disp->pages; page++)
+            SSD1306_GRAY_DRAW(&gray, 1 + (page & 1), plane, color,
+                              ssd1306_fill_rect(plane, 0, page * 8, disp->width, 8, color));
+    }
+    ssd1306_gray_step(&gray);
+}
+
+static const struct {
+    const char* name;
+    microbench_kernel_t kernel;
+} microbench_tests[] = {
+    { "fill", microbench_fill },
+    { "pixel", microbench_pixel },
+    { "glyph", microbench_glyph },
+    { "string", microbench_string },
+    { "dirty", microbench_dirty },
+    { "encode", microbench_encode },
+    { "refresh", microbench_refresh },
+    { "batch", microbench_batch },
+    { "gray", microbench_gray },
+};
+
+int main(int argc, char** argv){
+    uint32_t n = argc > 1 ? strtoul(argv[1], NULL, 0) : MICROBENCH_ITERATIONS;
+    uint32_t seed = 1;
+
+    for(int i = 0; i < MICROBENCH_POINTS; i++){
+        seed = seed * 1103515245 + 12345;
+        microbench_x[i] = (seed >> 16) & 0x7F;
+        seed = seed * 1103515245 + 12345;
+        microbench_y[i] = (seed >> 16) & 0x3F;
+    }
+
+    for(size_t d = 0; d < sizeof(microbench_displays) / sizeof(microbench_displays[0]); d++){
+        ssd1306_t* disp = microbench_displays[d];
+
+        ssd1306_init(disp);
+        ssd1306_refresh(disp);
+
+        for(size_t t = 0; t < sizeof(microbench_tests) / sizeof(microbench_tests[0]); t++){
+            /* start every kernel from a clean frame that is already sent */
+            ssd1306_fill_vram(disp, 0x00);
+            ssd1306_refresh(disp);
+            microbench_bytes = 0;
+
+            uint64_t start = microbench_ns();
+            for(uint32_t i = 0; i < n; i++)
+                microbench_tests[t].kernel(disp, i);
+            ssd1306_wait(disp);
+            uint64_t elapsed = microbench_ns() - start;
+
+            printf("microbench geometry=%ux%u test=%s n=%lu ns_op=%.1f bytes_op=%.1f\n",
+                   disp->width, disp->height, microbench_tests[t].name, (unsigned long)n,
+                   (double)elapsed / n, (double)microbench_bytes / n);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef OLED_SPLASH_H
+#define OLED_SPLASH_H
+
+/* boot splash, 128x32 in vram layout (page major, LSB on top) */
+static const uint8_t oled_splash[SSD1306_COLUMNS * SSD1306_PAGES] = {
+    0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0xE1, 0xE1, 0x19, 0x19, 0x19, 0x19, 0x19, 0x19, 0xE1, 0xE1, 0x01, 0x01, 0xF9, 0xF9,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xF9, 0xF9, 0x19, 0x19, 0x19, 0x19,
+    0x19, 0x19, 0x19, 0x19, 0x01, 0x01, 0xF9, 0xF9, 0x19, 0x19, 0x19, 0x19, 0x61, 0x61, 0x81, 0x81,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x19, 0x19, 0xF9, 0xF9, 0x19, 0x19, 0x01, 0x01, 0x01, 0x01, 0x61, 0x61, 0x19, 0x19, 0x19, 0x19,
+    0x19, 0x19, 0xE1, 0xE1, 0x01, 0x01, 0xE1, 0xE1, 0x19, 0x19, 0x19, 0x19, 0x19, 0x19, 0x61, 0x61,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x00, 0x00, 0xFF, 0xFF,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0xFF, 0xFF, 0x86, 0x86, 0x86, 0x86,
+    0x86, 0x86, 0x80, 0x80, 0x00, 0x00, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x60, 0x60, 0x1F, 0x1F,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x80, 0xFF, 0xFF, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0xE0, 0xE0, 0x98, 0x98,
+    0x86, 0x86, 0x81, 0x81, 0x00, 0x00, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x60, 0x60,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x81, 0x81, 0x81, 0x01, 0x01, 0x81,
+    0xE1, 0x81, 0x01, 0x01, 0x00, 0x00, 0x81, 0x81, 0x81, 0x01, 0x01, 0x81, 0x00, 0x80, 0x80, 0x00,
+    0x00, 0x80, 0xE0, 0x80, 0x00, 0x00, 0x00, 0x80, 0xA0, 0x00, 0x00, 0x80, 0x00, 0x80, 0x80, 0x00,
+    0x01, 0x01, 0x81, 0x81, 0x81, 0x81, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x89, 0x8A, 0x8A, 0x8A, 0x84, 0x80, 0x80,
+    0x87, 0x88, 0x88, 0x84, 0x80, 0x84, 0x8A, 0x8A, 0x8A, 0x8F, 0x80, 0x8F, 0x81, 0x80, 0x80, 0x81,
+    0x80, 0x80, 0x87, 0x88, 0x88, 0x84, 0x80, 0x88, 0x8F, 0x88, 0x80, 0x8F, 0x81, 0x80, 0x80, 0x8F,
+    0x80, 0x83, 0x94, 0x94, 0x94, 0x8F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF,
+};
+
+#endif
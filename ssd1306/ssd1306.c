@@ -3,13 +3,22 @@
 #include <string.h>
 #include <stdio.h>
 #include "ssd1306.h"
-#include "hardware/i2c.h"
 
 
+/* counter updates, compiled out without SSD1306_STATS */
+#if SSD1306_STATS
+#define SSD1306_STAT(disp, stmt)    do { ssd1306_stats_t* stats = &(disp)->stats; stmt; } while(0)
+#else
+#define SSD1306_STAT(disp, stmt)    do { } while(0)
+#endif
 
-
-static uint8_t i2c_output_buffer[1024]; /* i2c outgoing buffer */
-static uint8_t ssd1306_vram[512];
+/* refresh window, pages and columns inclusive */
+typedef struct {
+    uint8_t page_start;
+    uint8_t page_end;
+    uint8_t col_start;
+    uint8_t col_end;
+} ssd1306_window_t;
 
 static const uint8_t ssd1306_cmdlist_init[] = {
         SSD1306_SETDISPLAY_OFF,         /* turn off display */
@@ -24,7 +33,7 @@ static const uint8_t ssd1306_cmdlist_init[] = {
         0x14,                           /* charge pump ON (0x10 for OFF) */
         SSD1306_SETADDRESSMODE,         /* addressing mode */
         0x00,                           /* horizontal addressing mode */
-        SSD1306_COLSCAN_DESCENDING,     /* flip columns */
+        SSD1306_COLSCAN_ASCENDING,      /* don't flip columns */
         SSD1306_COMSCAN_ASCENDING,      /* don't flip rows (pages) */
         SSD1306_SETCOMPINS,             /* set COM pins */
         0x02,                           /* sequential pin mode */
@@ -40,47 +49,693 @@ static const uint8_t ssd1306_cmdlist_init[] = {
         SSD1306_SETDISPLAY_ON,          /* turn on display */
 };
 
-void ssd1306_send_cmdlist(const uint8_t* list, size_t lenght){
-    i2c_output_buffer[0] = SSD1306_CTRLBYTE_CMD;
-    memcpy(i2c_output_buffer + 1, list, lenght);
-    i2c_write_blocking(i2c0, SSD1306_ADDRESS, i2c_output_buffer, lenght + 1, false);
+/* geometry dependent bytes of ssd1306_cmdlist_init */
+#define SSD1306_INIT_MULTIPLEX  4
+#define SSD1306_INIT_COMPINS    15
+
+/* ssd1306_cmdlist_init up to the last command, SSD1306_SETDISPLAY_ON */
+#define SSD1306_INIT_DARK       (sizeof(ssd1306_cmdlist_init) - 1)
+
+static const uint8_t ssd1306_ctrlbyte_cmd = SSD1306_CTRLBYTE_CMD;
+static const uint8_t ssd1306_ctrlbyte_data = SSD1306_CTRLBYTE_DATA;
+
+#if SSD1306_STATS
+static void ssd1306_stats_blocked(ssd1306_t* disp, uint64_t start){
+    uint32_t elapsed = ssd1306_time_us() - start;
+
+    disp->stats.blocked_us += elapsed;
+    if(elapsed > disp->stats.blocked_max_us)
+        disp->stats.blocked_max_us = elapsed;
+}
+#endif
+
+/* the first error while a batch is open is kept for ssd1306_batch_end */
+static int ssd1306_batch_status(ssd1306_t* disp, int ret){
+    if(ret < 0 && disp->batch_depth && disp->batch_error == 0)
+        disp->batch_error = ret;
+    return ret;
+}
+
+static int ssd1306_transport_write(ssd1306_t* disp, const ssd1306_segment_t* segments, size_t count){
+#if SSD1306_STATS
+    uint64_t start = ssd1306_time_us();
+#endif
+    int ret = disp->transport->write(disp->transport->context, disp->address, segments, count);
+
+#if SSD1306_STATS
+    ssd1306_stats_blocked(disp, start);
+    disp->stats.transactions++;
+    if(ret < 0)
+        disp->stats.errors++;
+#endif
+    return ssd1306_batch_status(disp, ret);
+}
+
+/*
+ * One blocking transaction, pending batched bytes and streams go first to keep
+ * the order. Returns the bytes written, or the first transport error of the
+ * three steps.
+ */
+static int ssd1306_write(ssd1306_t* disp, const ssd1306_segment_t* segments, size_t count){
+    int flushed = ssd1306_batch_flush(disp);
+    int waited = ssd1306_wait(disp);
+    int ret = ssd1306_transport_write(disp, segments, count);
+
+    if(flushed < 0)
+        return flushed;
+    return waited < 0 ? waited : ret;
+}
+
+/*
+ * Batch encoder. Commands and data are collected into a single transaction.
+ * Only the last run of a transaction can use a plain control byte (Co = 0),
+ * everything before it has to be sent as control byte / byte pairs with the
+ * continuation bit set. So when the run type changes, a short open run is
+ * rewritten into pairs in place, while a long one is cheaper as the tail of
+ * its own transaction and gets flushed.
+ */
+static void ssd1306_batch_close_run(ssd1306_t* disp){
+    uint8_t* buffer = disp->batch_buffer;
+    size_t run = disp->batch_run;
+    size_t count;
+
+    if(run == SSD1306_BATCH_NONE)
+        return;
+
+    count = disp->batch_len - run - 1;
+    if(count > SSD1306_BATCH_PAIR_MAX || run + 2 * count > SSD1306_BATCH_SIZE){
+        ssd1306_batch_flush(disp);
+        return;
+    }
+
+    /* expand backwards, every byte gets its own control byte */
+    uint8_t ctrl = buffer[run] | SSD1306_CTRLBYTE_CO;
+    for(size_t i = count; i-- > 0; ){
+        buffer[run + 2 * i + 1] = buffer[run + 1 + i];
+        buffer[run + 2 * i] = ctrl;
+    }
+    disp->batch_len = run + 2 * count;
+    disp->batch_run = SSD1306_BATCH_NONE;
+}
+
+static void ssd1306_batch_append(ssd1306_t* disp, uint8_t ctrl, const uint8_t* bytes, size_t lenght){
+    while(lenght){
+        /* continue the open run or start a new one */
+        if(disp->batch_run == SSD1306_BATCH_NONE || disp->batch_buffer[disp->batch_run] != ctrl){
+            ssd1306_batch_close_run(disp);
+            if(disp->batch_len + 2 > SSD1306_BATCH_SIZE)
+                ssd1306_batch_flush(disp);
+            disp->batch_run = disp->batch_len;
+            disp->batch_buffer[disp->batch_len++] = ctrl;
+        }
+
+        size_t room = SSD1306_BATCH_SIZE - disp->batch_len;
+        size_t n = lenght < room ? lenght : room;
+        memcpy(&disp->batch_buffer[disp->batch_len], bytes, n);
+        disp->batch_len += n;
+        bytes += n;
+        lenght -= n;
+
+        /* a full data run carries on in the next transaction, GDDRAM pointer is kept */
+        if(lenght)
+            ssd1306_batch_flush(disp);
+    }
+}
+
+void ssd1306_batch_begin(ssd1306_t* disp){
+    if(disp->batch_depth++ == 0)
+        disp->batch_error = 0;
+}
+
+/*
+ * The outermost end sends the batch. Returns the first transport error since
+ * the outermost begin, including transactions flushed early, or 0.
+ */
+int ssd1306_batch_end(ssd1306_t* disp){
+    if(disp->batch_depth == 1)
+        ssd1306_batch_flush(disp);
+    if(disp->batch_depth)
+        disp->batch_depth--;
+
+    return disp->batch_error;
+}
+
+/* sends the collected bytes now, returns the bytes written or the transport error */
+int ssd1306_batch_flush(ssd1306_t* disp){
+    ssd1306_segment_t segment = { disp->batch_buffer, disp->batch_len };
+    int waited, ret;
+
+    if(disp->batch_len == 0)
+        return 0;
+
+    waited = ssd1306_wait(disp);
+    ret = ssd1306_transport_write(disp, &segment, 1);
+    disp->batch_len = 0;
+    disp->batch_run = SSD1306_BATCH_NONE;
+
+    return waited < 0 ? waited : ret;
+}
+
+/* returns the bytes written or the transport error, 0 while batched (see ssd1306_batch_end) */
+int ssd1306_send_cmdlist(ssd1306_t* disp, const uint8_t* list, size_t lenght){
+    ssd1306_segment_t segments[] = {
+        { &ssd1306_ctrlbyte_cmd, 1 },
+        { list, lenght }
+    };
+
+    SSD1306_STAT(disp, stats->cmd_bytes += lenght);
+
+    /* commands must not be split across transactions */
+    if(disp->batch_depth && lenght < SSD1306_BATCH_SIZE / 2){
+        if(disp->batch_run == SSD1306_BATCH_NONE || disp->batch_buffer[disp->batch_run] != SSD1306_CTRLBYTE_CMD)
+            ssd1306_batch_close_run(disp);
+        if(disp->batch_len + lenght + 1 > SSD1306_BATCH_SIZE)
+            ssd1306_batch_flush(disp);
+        ssd1306_batch_append(disp, SSD1306_CTRLBYTE_CMD, list, lenght);
+        return 0;
+    }
+
+    return ssd1306_write(disp, segments, 2);
+}
+
+/* same as ssd1306_send_cmdlist, nothing is sent while scrolling */
+int ssd1306_send_data(ssd1306_t* disp, const uint8_t* data, size_t lenght){
+    ssd1306_segment_t segments[] = {
+        { &ssd1306_ctrlbyte_data, 1 },
+        { data, lenght }
+    };
+
+    /* GDDRAM is off limits while scrolling */
+    if(disp->scrolling)
+        return 0;
+
+    SSD1306_STAT(disp, stats->data_bytes += lenght);
+
+    if(disp->batch_depth){
+        ssd1306_batch_append(disp, SSD1306_CTRLBYTE_DATA, data, lenght);
+        return 0;
+    }
+
+    return ssd1306_write(disp, segments, 2);
+}
+
+void ssd1306_mark_dirty(ssd1306_t* disp, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end){
+    if(col_end > disp->width - 1) col_end = disp->width - 1;
+    if(page_end > disp->pages - 1) page_end = disp->pages - 1;
+
+    for(int page = page_start; page <= page_end; page++){
+        if(col_start < disp->dirty_start[page]) disp->dirty_start[page] = col_start;
+        if(col_end > disp->dirty_stop[page]) disp->dirty_stop[page] = col_end;
+    }
+}
+
+static void ssd1306_clear_dirty(ssd1306_t* disp){
+    memset(disp->dirty_start, disp->width, disp->pages);
+    memset(disp->dirty_stop, 0, disp->pages);
+}
+
+/* sends one rectangular window of vram straight from vram, one segment per page */
+static int ssd1306_send_window(ssd1306_t* disp, const ssd1306_window_t* window){
+    uint8_t cfg[] = {
+        SSD1306_SETPAGERANGE, window->page_start, window->page_end,
+        SSD1306_SETCOLRANGE, window->col_start, window->col_end
+    };
+    ssd1306_segment_t segments[SSD1306_MAX_PAGES + 1];
+    size_t width = window->col_end - window->col_start + 1;
+    size_t count = 0;
+    int ret;
+
+    ret = ssd1306_send_cmdlist(disp, cfg, sizeof(cfg));
+    SSD1306_STAT(disp, stats->data_bytes += width * (window->page_end - window->page_start + 1));
+
+    segments[count].data = &ssd1306_ctrlbyte_data;
+    segments[count++].lenght = 1;
+
+    /* full width windows are contiguous in vram */
+    if(width == disp->width){
+        segments[count].data = &disp->vram[window->page_start * disp->width];
+        segments[count++].lenght = (window->page_end - window->page_start + 1) * disp->width;
+    }
+    else{
+        for(int page = window->page_start; page <= window->page_end; page++){
+            segments[count].data = &disp->vram[page * disp->width + window->col_start];
+            segments[count++].lenght = width;
+        }
+    }
+
+    if(ret < 0)
+        return ret;
+    return ssd1306_write(disp, segments, count);
+}
+
+/*
+ * Splits the dirty parts of vram into windows. Consecutive dirty pages are
+ * either sent as separate windows or merged into one window spanning the union
+ * of their columns, whichever costs fewer bus bytes (SSD1306_WINDOW_OVERHEAD
+ * per window plus one byte per column and page). Merging everything is one
+ * candidate, so scattered updates fall back to a single full-frame style
+ * transfer on their own. Returns the number of windows and clears the dirty state.
+ * Inlined per geometry by SSD1306_SPECIALISE, W and P are the columns and pages.
+ */
+static inline __attribute__((always_inline))
+int ssd1306_plan(ssd1306_t* disp, ssd1306_window_t* windows, const int W, const int P){
+    const uint8_t* dirty_start = disp->dirty_start;
+    const uint8_t* dirty_stop = disp->dirty_stop;
+    uint16_t cost[SSD1306_MAX_PAGES + 1];   /* cheapest cost of sending pages [0, i) */
+    uint8_t  first[SSD1306_MAX_PAGES + 1];  /* first page of the last window of that plan */
+    uint8_t  col_start[SSD1306_MAX_PAGES + 1];
+    uint8_t  col_end[SSD1306_MAX_PAGES + 1];
+    int count = 0;
+
+    cost[0] = 0;
+    for(int i = 1; i <= P; i++){
+        uint8_t lo = W, hi = 0;
+
+        /* clean page, nothing to send */
+        cost[i] = cost[i - 1];
+        first[i] = i;
+
+        if(dirty_start[i - 1] > dirty_stop[i - 1])
+            continue;
+
+        cost[i] = UINT16_MAX;
+        /* try every window ending at page i - 1 */
+        for(int j = i; j >= 1; j--){
+            if(dirty_start[j - 1] <= dirty_stop[j - 1]){
+                if(dirty_start[j - 1] < lo) lo = dirty_start[j - 1];
+                if(dirty_stop[j - 1] > hi) hi = dirty_stop[j - 1];
+            }
+            else if(j < i)
+                continue; /* never start a window on a clean page */
+
+            uint16_t c = cost[j - 1] + SSD1306_WINDOW_OVERHEAD + (i - j + 1) * (hi - lo + 1);
+            if(c < cost[i]){
+                cost[i] = c;
+                first[i] = j - 1;
+                col_start[i] = lo;
+                col_end[i] = hi;
+            }
+        }
+    }
+
+    /* walk the plan backwards */
+    for(int i = P; i > 0; ){
+        if(first[i] == i){
+            i--;
+            continue;
+        }
+        windows[count].page_start = first[i];
+        windows[count].page_end = i - 1;
+        windows[count].col_start = col_start[i];
+        windows[count].col_end = col_end[i];
+        count++;
+        i = first[i];
+    }
+
+    ssd1306_clear_dirty(disp);
+    return count;
+}
+
+static int ssd1306_plan_refresh(ssd1306_t* disp, ssd1306_window_t* windows){
+    int count;
+
+    SSD1306_STAT(disp, stats->refreshes++);
+
+    /* no frame buffer to send from */
+    if(disp->strip){
+        ssd1306_clear_dirty(disp);
+        return 0;
+    }
+
+    /* no GDDRAM access while scrolling, everything stays dirty until it stops */
+    if(disp->scrolling)
+        return 0;
+
+    SSD1306_SPECIALISE(disp, count = ssd1306_plan(disp, windows, W, P));
+
+#if SSD1306_STATS
+    for(int i = 0; i < count; i++)
+        disp->stats.refresh_bytes += (windows[i].page_end - windows[i].page_start + 1) *
+                                     (windows[i].col_end - windows[i].col_start + 1);
+#endif
+    return count;
+}
+
+/* sends every dirty window, returns the first transport error or 0 */
+int ssd1306_refresh(ssd1306_t* disp){
+    ssd1306_window_t windows[SSD1306_MAX_PAGES];
+    int count = ssd1306_plan_refresh(disp, windows);
+    int error = 0;
+
+    for(int i = 0; i < count; i++){
+        int ret = ssd1306_send_window(disp, &windows[i]);
+        if(ret < 0 && error == 0)
+            error = ret;
+    }
+
+    return error;
+}
+
+/* transport is done with the front buffer */
+static void ssd1306_stream_done(void* arg){
+    ssd1306_t* disp = (ssd1306_t*)arg;
+
+    disp->stream_busy = false;
+
+    if(disp->stream_callback)
+        disp->stream_callback(disp);
 }
 
-void ssd1306_send_data(const uint8_t* data, size_t lenght){
-    i2c_output_buffer[0] = SSD1306_CTRLBYTE_DATA;
-    memcpy(i2c_output_buffer + 1, data, lenght);
-    i2c_write_blocking(i2c0, SSD1306_ADDRESS, i2c_output_buffer, lenght + 1, false);    
+/* appends one transaction to the word stream, STOP is flagged on its last byte */
+static uint16_t* ssd1306_encode(uint16_t* out, uint8_t ctrl, const uint8_t* data, size_t lenght){
+    *out++ = ctrl;
+    while(lenght--)
+        *out++ = *data++;
+    out[-1] |= SSD1306_STREAM_STOP;
+    return out;
 }
 
-void ssd1306_refresh(){
-    ssd1306_send_data(ssd1306_vram, sizeof(ssd1306_vram));
+/* encodes the windows into the front buffer, returns the number of words */
+static inline __attribute__((always_inline))
+size_t ssd1306_encode_windows(ssd1306_t* disp, const ssd1306_window_t* windows, int count, const int W){
+    uint16_t* out = disp->stream;
+
+    for(int i = 0; i < count; i++){
+        const ssd1306_window_t* window = &windows[i];
+        uint8_t cfg[] = {
+            SSD1306_SETPAGERANGE, window->page_start, window->page_end,
+            SSD1306_SETCOLRANGE, window->col_start, window->col_end
+        };
+        out = ssd1306_encode(out, SSD1306_CTRLBYTE_CMD, cfg, sizeof(cfg));
+
+        *out++ = SSD1306_CTRLBYTE_DATA;
+        for(int page = window->page_start; page <= window->page_end; page++){
+            const uint8_t* row = &disp->vram[page * W];
+            for(int col = window->col_start; col <= window->col_end; col++)
+                *out++ = row[col];
+        }
+        out[-1] |= SSD1306_STREAM_STOP;
+    }
+
+    return out - disp->stream;
+}
+
+/*
+ * Snapshots the dirty windows into the front buffer and hands them to the
+ * transport (DMA on RP2040). Returns as soon as the transfer is started,
+ * drawing into vram may continue right away. Waits for the previous
+ * asynchronous refresh first (fence). On RP2040 the callback runs in
+ * interrupt context once the last byte is queued.
+ */
+void ssd1306_refresh_async(ssd1306_t* disp, ssd1306_callback_t callback){
+    ssd1306_refresh_async_cmd(disp, NULL, 0, callback);
+}
+
+/*
+ * Same, with up to SSD1306_STREAM_CMD_MAX commands sent in the same stream
+ * right after the last window, so they take effect as the data lands.
+ */
+void ssd1306_refresh_async_cmd(ssd1306_t* disp, const uint8_t* cmds, size_t lenght, ssd1306_callback_t callback){
+    ssd1306_window_t windows[SSD1306_MAX_PAGES];
+    size_t words;
+
+    ssd1306_batch_flush(disp);
+    ssd1306_wait(disp);
+
+    if(lenght > SSD1306_STREAM_CMD_MAX)
+        lenght = SSD1306_STREAM_CMD_MAX;
+
+    int count = ssd1306_plan_refresh(disp, windows);
+    if(count == 0 && lenght == 0){
+        if(callback)
+            callback(disp);
+        return;
+    }
+
+    SSD1306_SPECIALISE(disp, (void)P; words = ssd1306_encode_windows(disp, windows, count, W));
+    if(lenght)
+        words = ssd1306_encode(&disp->stream[words], SSD1306_CTRLBYTE_CMD, cmds, lenght) - disp->stream;
+
+    SSD1306_STAT(disp, stats->transactions += 2 * count + (lenght != 0);
+                       stats->cmd_bytes += 6 * count + lenght;
+                       stats->data_bytes += words - 8 * count - (lenght ? lenght + 1 : 0));
+
+    disp->stream_callback = callback;
+    disp->stream_busy = true;
+    disp->transport->write_stream(disp->transport->context, disp->address,
+                                  disp->stream, words, ssd1306_stream_done, disp);
 }
 
-void ssd1306_draw_pixel(uint16_t x, uint16_t y, uint8_t value){
-    /* send configuration message */
+/*
+ * Sends one full width page from data through the asynchronous path, after
+ * the previous stream is done. data may be reused as soon as this returns.
+ * While scrolling the page is only marked dirty, which defers it for a full
+ * display and drops it for a strip display.
+ */
+void ssd1306_send_page_async(ssd1306_t* disp, uint8_t page, const uint8_t* data){
     uint8_t cfg[] = {
-        SSD1306_SETPAGERANGE,        /* sets page range */
-        y >> 3,                      //   y / 8 - fast division
-        y >> 3,                      //   y / 8 - fast division
-        SSD1306_SETCOLRANGE,         // sets column range:
-        x,                           //   x
-        x                            //   x
+        SSD1306_SETPAGERANGE, page, page,
+        SSD1306_SETCOLRANGE, 0, disp->width - 1
     };
+    uint16_t* out = disp->stream;
+
+    if(disp->scrolling){
+        ssd1306_mark_dirty(disp, 0, disp->width - 1, page, page);
+        return;
+    }
+
+    ssd1306_batch_flush(disp);
+    ssd1306_wait(disp);
+
+    out = ssd1306_encode(out, SSD1306_CTRLBYTE_CMD, cfg, sizeof(cfg));
+    out = ssd1306_encode(out, SSD1306_CTRLBYTE_DATA, data, disp->width);
+
+    SSD1306_STAT(disp, stats->transactions += 2;
+                       stats->cmd_bytes += sizeof(cfg);
+                       stats->data_bytes += disp->width);
+
+    disp->stream_callback = NULL;
+    disp->stream_busy = true;
+    disp->transport->write_stream(disp->transport->context, disp->address,
+                                  disp->stream, out - disp->stream, ssd1306_stream_done, disp);
+}
+
+bool ssd1306_busy(ssd1306_t* disp){
+    return disp->stream_busy;
+}
+
+/*
+ * Blocks until the asynchronous refresh is done and the bus is idle again.
+ * Returns the transport error if a streamed transaction was NACKed or
+ * aborted, which is the only place those show up.
+ */
+int ssd1306_wait(ssd1306_t* disp){
+#if SSD1306_STATS
+    uint64_t start = ssd1306_time_us();
+#endif
+    int ret;
+
+    while(disp->stream_busy)
+        ;
+
+    ret = disp->transport->wait(disp->transport->context);
+#if SSD1306_STATS
+    ssd1306_stats_blocked(disp, start);
+    if(ret < 0)
+        disp->stats.errors++;
+#endif
+    return ssd1306_batch_status(disp, ret);
+}
+
+void ssd1306_stats_snapshot(ssd1306_t* disp, ssd1306_stats_t* stats){
+#if SSD1306_STATS
+    *stats = disp->stats;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void ssd1306_stats_reset(ssd1306_t* disp){
+#if SSD1306_STATS
+    memset(&disp->stats, 0, sizeof(disp->stats));
+#endif
+}
+
+/* one line of key=value pairs on stdio, dirty is the sent share of the refreshed frames in permille */
+void ssd1306_stats_dump(ssd1306_t* disp){
+    ssd1306_stats_t stats;
+    uint64_t frame_bytes;
+
+    ssd1306_stats_snapshot(disp, &stats);
+    frame_bytes = (uint64_t)stats.refreshes * disp->width * disp->pages;
+
+    printf("ssd1306 addr=0x%02x transactions=%lu cmd_bytes=%lu data_bytes=%lu errors=%lu refreshes=%lu "
+           "blocked_us=%llu blocked_max_us=%lu dirty_permille=%lu\n",
+           disp->address, (unsigned long)stats.transactions, (unsigned long)stats.cmd_bytes,
+           (unsigned long)stats.data_bytes, (unsigned long)stats.errors, (unsigned long)stats.refreshes,
+           (unsigned long long)stats.blocked_us, (unsigned long)stats.blocked_max_us,
+           (unsigned long)(frame_bytes ? stats.refresh_bytes * 1000 / frame_bytes : 0));
+}
+
+/* the wait collects errors of earlier streams on the bus before the refresh fences on it */
+static void ssd1306_refresh_start(ssd1306_t* disp, int* error){
+    int ret = ssd1306_wait(disp);
+
+    if(ret < 0 && *error == 0)
+        *error = ret;
+    ssd1306_refresh_async(disp, NULL);
+}
+
+/*
+ * Refreshes up to SSD1306_DISPLAYS_MAX displays at once. A refresh is
+ * started on every display whose bus is free, so displays on different
+ * controllers transfer in parallel while displays sharing one go out back
+ * to back. When every bus left is busy, the next display blocks in the wait
+ * for its bus. Returns once all of them are done, with the first transport
+ * error, or -1 without sending anything for too many displays.
+ */
+int ssd1306_refresh_displays(ssd1306_t* const* displays, size_t count){
+    uint32_t pending;
+    int error = 0;
+
+    if(count > SSD1306_DISPLAYS_MAX)
+        return -1;
+    pending = count == SSD1306_DISPLAYS_MAX ? UINT32_MAX : ((uint32_t)1 << count) - 1;
+
+    while(pending){
+        size_t next = count;
+
+        for(size_t i = 0; i < count; i++){
+            const ssd1306_transport_t* transport = displays[i]->transport;
+
+            if(!(pending & ((uint32_t)1 << i)))
+                continue;
+            if(transport->busy(transport->context)){
+                if(next == count)
+                    next = i;
+                continue;
+            }
+
+            ssd1306_refresh_start(displays[i], &error);
+            pending &= ~((uint32_t)1 << i);
+        }
+
+        if(next < count){
+            ssd1306_refresh_start(displays[next], &error);
+            pending &= ~((uint32_t)1 << next);
+        }
+    }
+
+    for(size_t i = 0; i < count; i++){
+        int ret = ssd1306_wait(displays[i]);
+        if(ret < 0 && error == 0)
+            error = ret;
+    }
 
-    ssd1306_send_cmdlist(cfg, sizeof(cfg)); 
-    
-    uint8_t data = value << (y & 0x07);  /*   y % 8 */
+    return error;
+}
 
-    ssd1306_send_data(&data, sizeof(data));
+void ssd1306_fill_vram(ssd1306_t* disp, uint8_t value){
+    if(!disp->strip)
+        memset(disp->vram, value, disp->width * disp->pages);
+    ssd1306_mark_dirty(disp, 0, disp->width - 1, 0, disp->pages - 1);
 }
 
-void ssd1306_fill_vram(uint8_t value){
-    memset(ssd1306_vram, value, sizeof(ssd1306_vram));
+/* multiplex and COM pin layout follow the panel height */
+static void ssd1306_init_list(ssd1306_t* disp, uint8_t* list){
+    memcpy(list, ssd1306_cmdlist_init, sizeof(ssd1306_cmdlist_init));
+    list[SSD1306_INIT_MULTIPLEX] = disp->height - 1;
+    list[SSD1306_INIT_COMPINS] = disp->height > 32 ? 0x12 : 0x02;  /* alternative : sequential */
 }
 
-void ssd1306_init(){
-    ssd1306_send_cmdlist(ssd1306_cmdlist_init, sizeof(ssd1306_cmdlist_init));
-    memset(ssd1306_vram, 0x00, sizeof(ssd1306_vram));
-    memset(i2c_output_buffer, 0x00, sizeof(i2c_output_buffer));
+/* returns the bytes written or the transport error, the display state is reset either way */
+int ssd1306_init(ssd1306_t* disp){
+    uint8_t list[sizeof(ssd1306_cmdlist_init)];
+    int ret;
+
+    /* the list deactivates scrolling */
+    ssd1306_init_list(disp, list);
+    ret = ssd1306_send_cmdlist(disp, list, sizeof(list));
+    disp->scrolling = false;
+    memset(disp->vram, 0x00, disp->strip ? disp->width : disp->width * disp->pages);
+
+    /* GDDRAM content is undefined after reset, first refresh sends everything */
+    ssd1306_clear_dirty(disp);
+    ssd1306_mark_dirty(disp, 0, disp->width - 1, 0, disp->pages - 1);
+
+    return ret;
+}
+
+/* Draws character from font table at the current GDDRAM pointer */
+void ssd1306_draw_character(ssd1306_t* disp, uint8_t c){
+    ssd1306_batch_begin(disp);
+    for(int i = 0; i < 6; i++)
+        ssd1306_send_data(disp, &ssd1306_font6x8[c][i], 1);
+    ssd1306_batch_end(disp);
+}
+
+/* address and control byte only, returns a negative transport error when nobody answers */
+int ssd1306_probe(ssd1306_t* disp){
+    ssd1306_segment_t segment = { &ssd1306_ctrlbyte_cmd, 1 };
+
+    ssd1306_batch_flush(disp);
+    ssd1306_wait(disp);
+    return ssd1306_transport_write(disp, &segment, 1);
 }
 
+/*
+ * Fast boot. Init list, full screen window and splash image (width * pages
+ * bytes in vram layout, usually in flash) go out as a single transaction:
+ * the commands as Co control byte pairs, then one data run sent straight
+ * from the splash. The display is only switched on by a short second
+ * transaction once GDDRAM holds the splash, so its power-on content is
+ * never shown. vram is set to the splash so refreshes carry on from it.
+ * Returns the bytes written or the transport error.
+ */
+int ssd1306_init_splash(ssd1306_t* disp, const uint8_t* splash){
+    static const uint8_t display_on = SSD1306_SETDISPLAY_ON;
+    uint8_t list[SSD1306_INIT_DARK + 6];
+    uint8_t pairs[2 * sizeof(list)];
+    size_t lenght = disp->width * disp->pages;
+    ssd1306_segment_t segments[] = {
+        { pairs, sizeof(pairs) },
+        { &ssd1306_ctrlbyte_data, 1 },
+        { splash, lenght }
+    };
+    ssd1306_segment_t on[] = {
+        { &ssd1306_ctrlbyte_cmd, 1 },
+        { &display_on, 1 }
+    };
+    int ret, ret_on;
+
+    /* the window takes the place of SSD1306_SETDISPLAY_ON */
+    ssd1306_init_list(disp, list);
+    list[SSD1306_INIT_DARK + 0] = SSD1306_SETPAGERANGE;
+    list[SSD1306_INIT_DARK + 1] = 0;
+    list[SSD1306_INIT_DARK + 2] = disp->pages - 1;
+    list[SSD1306_INIT_DARK + 3] = SSD1306_SETCOLRANGE;
+    list[SSD1306_INIT_DARK + 4] = 0;
+    list[SSD1306_INIT_DARK + 5] = disp->width - 1;
+
+    for(size_t i = 0; i < sizeof(list); i++){
+        pairs[2 * i] = SSD1306_CTRLBYTE_CO | SSD1306_CTRLBYTE_CMD;
+        pairs[2 * i + 1] = list[i];
+    }
+
+    SSD1306_STAT(disp, stats->cmd_bytes += sizeof(list) + 1;
+                       stats->data_bytes += lenght);
+
+    if(!disp->strip)
+        memcpy(disp->vram, splash, lenght);
+    ssd1306_clear_dirty(disp);
+    disp->scrolling = false;    /* deactivated by the list ahead of the data */
+
+    ssd1306_batch_flush(disp);
+    ssd1306_wait(disp);
+    ret = ssd1306_transport_write(disp, segments, 3);
+    if(ret < 0)
+        return ret;
+
+    ret_on = ssd1306_transport_write(disp, on, 2);
+    return ret_on < 0 ? ret_on : ret + ret_on;
+}
@@ -1,7 +1,11 @@
 #ifndef SSD1306_H
 #define SSD1306_H
 
-/* Hardware description */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Hardware description - default panel, others are set up with SSD1306_DEFINE */
 #define SSD1306_ADDRESS     0x3C
 #define SSD1306_ROWS        32 
 #define SSD1306_COLUMNS     128
@@ -9,10 +13,33 @@
 #define SSD1306_PAGE_STOP   ((SSD1306_ROWS / 8) - 1)
 #define SSD1306_COL_START   0
 #define SSD1306_COL_STOP    (SSD1306_COLUMNS - 1)
+#define SSD1306_PAGES       (SSD1306_ROWS / 8)
+#define SSD1306_MAX_PAGES   8       /* controller limit, 64 rows */
+
+/* Refresh cost model - bus bytes spent on one extra update window:
+ * address + control byte + 6 range command bytes, address + control byte
+ * for the data transfer, and roughly one byte time each for START/STOP */
+#define SSD1306_WINDOW_OVERHEAD     12
+
+/* Batch encoder - transaction buffer size, and the longest run that is still
+ * rewritten into Co control byte pairs (2 bytes per byte) rather than ending
+ * the transaction when commands and data are mixed */
+#define SSD1306_BATCH_SIZE          256
+#define SSD1306_BATCH_PAIR_MAX      8
+
+/* Multiple displays - most displays one ssd1306_refresh_displays call takes,
+ * the bits of its pending mask */
+#define SSD1306_DISPLAYS_MAX        32
+
+/* Instrumentation - per display counters, see ssd1306_stats_t */
+#ifndef SSD1306_STATS
+#define SSD1306_STATS               0
+#endif
 
 /* SSD1306 commands - see datasheet */
 #define SSD1306_CTRLBYTE_CMD        0x00    /* indicates following bytes are commands */
 #define SSD1306_CTRLBYTE_DATA       0x40    /* indicates following bytes are data */
+#define SSD1306_CTRLBYTE_CO         0x80    /* continuation: only one byte follows, then another control byte */
 
 /* Fundamental Command Table (p. 28) */
 #define SSD1306_SETCONTRAST         0x81    // double-byte command to set contrast (1-256)
@@ -32,6 +59,16 @@
 #define SSD1306_SCROLL_DEACTIVATE       0x2E    // stop scrolling
 #define SSD1306_SCROLL_ACTIVATE         0x2F    // start scrolling
 
+/* scroll step interval, in frames */
+#define SSD1306_SCROLL_FRAMES_2         0x07
+#define SSD1306_SCROLL_FRAMES_3         0x04
+#define SSD1306_SCROLL_FRAMES_4         0x05
+#define SSD1306_SCROLL_FRAMES_5         0x00
+#define SSD1306_SCROLL_FRAMES_25        0x06
+#define SSD1306_SCROLL_FRAMES_64        0x01
+#define SSD1306_SCROLL_FRAMES_128       0x02
+#define SSD1306_SCROLL_FRAMES_256       0x03
+
 // Addressing Setting Command Table (pp. 30-31)
 #define SSD1306_PAGE_COLSTART_LOW   0x00    // set lower 4 bits of column start address by ORing 4 LSBs
 #define SSD1306_PAGE_COLSTART_HIGH  0x10    // set upper 4 bits of column start address by ORing 4 LSBs
@@ -60,14 +97,389 @@
 #define SSD1306_SETCHARGEPUMP       0x8D    // enable / disable charge pump
 
 
+/* drawing colors */
+#define SSD1306_BLACK       0       /* clear pixels */
+#define SSD1306_WHITE       1       /* set pixels */
+#define SSD1306_INVERT      2       /* toggle pixels */
+
+/*
+ * Bitmap font. Every glyph is width columns of pages bytes (column major,
+ * LSB on top). Proportional fonts have per glyph metrics, the first drawn
+ * column in the upper and the drawn width in the lower nibble.
+ */
+typedef struct {
+    const uint8_t* glyphs;
+    const uint8_t* metrics;     /* NULL for monospaced fonts */
+    uint8_t width;              /* glyph cell width in columns */
+    uint8_t pages;              /* glyph height in pages */
+    uint8_t first;              /* first character in the font */
+    uint8_t count;              /* number of glyphs */
+    uint8_t spacing;            /* columns added after proportional glyphs */
+} ssd1306_font_t;
+
+/* fonts (ssd1306_font.c) */
+extern const uint8_t ssd1306_font6x8[][6];
+extern const ssd1306_font_t ssd1306_font_6x8;
+extern const ssd1306_font_t ssd1306_font_6x8_prop;
+extern const ssd1306_font_t ssd1306_font_12x16;
+extern const ssd1306_font_t ssd1306_font_18x24;
+
+/* Glyph cache - pre-shifted glyphs for text that is not page aligned.
+ * Glyphs bigger than SSD1306_GLYPH_CACHE_BYTES after shifting bypass it */
+#define SSD1306_GLYPH_CACHE_SIZE    32
+#define SSD1306_GLYPH_CACHE_BYTES   16
+
+typedef struct ssd1306 ssd1306_t;
+
+/*
+ * Driver counters, collected when built with SSD1306_STATS. Byte counts are
+ * payload bytes without control and address bytes. Blocked time is spent in
+ * blocking transport writes and in waiting for asynchronous refreshes.
+ */
+typedef struct {
+    uint32_t transactions;
+    uint32_t cmd_bytes;
+    uint32_t data_bytes;
+    uint32_t errors;                /* NACKs and timeouts reported by the transport */
+    uint32_t refreshes;
+    uint32_t blocked_max_us;        /* worst single blocking call */
+    uint64_t blocked_us;
+    uint64_t refresh_bytes;         /* vram bytes sent by refreshes, against refreshes * frame size */
+} ssd1306_stats_t;
+
+/* called once an asynchronous refresh has been handed to the bus */
+typedef void (*ssd1306_callback_t)(ssd1306_t* disp);
+
+/* transport completion, arg is whatever was passed to write_stream */
+typedef void (*ssd1306_done_t)(void* arg);
+
+/* ends a transaction in a transport word stream, same bit as IC_DATA_CMD STOP on RP2040 */
+#define SSD1306_STREAM_STOP     0x0200
+
+/* commands ssd1306_refresh_async_cmd can append to a refresh */
+#define SSD1306_STREAM_CMD_MAX  4
+
+/* worst case stream: every pixel plus control and window commands for every page, and trailing commands */
+#define SSD1306_STREAM_WORDS(width, height)     ((width) * ((height) / 8) + ((height) / 8) * 9 + 1 + SSD1306_STREAM_CMD_MAX)
+
+/* one piece of a gathered transaction */
+typedef struct {
+    const uint8_t* data;
+    size_t lenght;
+} ssd1306_segment_t;
+
+/*
+ * Bus transport used by the driver, one per I2C controller. write sends one
+ * complete transaction (START, address, bytes, STOP) gathered from several
+ * segments, so control bytes and vram go out without being copied together
+ * first. It returns the number of bytes written or a negative error.
+ * write_stream queues a sequence of transactions encoded as 16-bit words
+ * (data byte | SSD1306_STREAM_STOP on the last byte of each one) and calls
+ * done once the stream buffer is no longer needed. busy tells whether a stream
+ * is still being queued, wait blocks until the bus is idle again and returns
+ * a negative error if a streamed transaction was aborted since the last wait.
+ */
+typedef struct {
+    void* context;
+    int  (*write)(void* context, uint8_t address, const ssd1306_segment_t* segments, size_t count);
+    void (*write_stream)(void* context, uint8_t address, const uint16_t* stream, size_t count,
+                         ssd1306_done_t done, void* arg);
+    bool (*busy)(void* context);
+    int  (*wait)(void* context);
+} ssd1306_transport_t;
+
+/* provided by the platform file (ssd1306_pico.c or the host emulator) */
+extern const ssd1306_transport_t ssd1306_transport_default;
+uint64_t ssd1306_time_us(void);
+extern const ssd1306_transport_t ssd1306_transport_i2c1;    /* RP2040 second controller */
+
+/* Display context. Set up with SSD1306_DEFINE, which also allocates the buffers */
+struct ssd1306 {
+    const ssd1306_transport_t* transport;
+    uint8_t  address;
+    uint8_t  width;                 /* columns */
+    uint8_t  height;                /* rows */
+    uint8_t  pages;
+
+    /* frame buffer, page major: byte [page * width + x] holds rows page * 8 .. page * 8 + 7,
+     * LSB on top. Call ssd1306_mark_dirty after writing it directly */
+    uint8_t* vram;
+    bool     strip;                 /* vram is one page, see SSD1306_DEFINE_STRIP */
+
+    /* dirty column range of every page, clean pages have start > stop */
+    uint8_t* dirty_start;
+    uint8_t* dirty_stop;
+
+    /* asynchronous refresh front buffer, SSD1306_STREAM_WORDS long */
+    uint16_t* stream;
+    volatile bool stream_busy;
+    ssd1306_callback_t stream_callback;
+
+    /* batch encoder, SSD1306_BATCH_SIZE buffer */
+    uint8_t* batch_buffer;
+    size_t   batch_len;
+    size_t   batch_run;             /* control byte of the open run */
+    uint8_t  batch_depth;
+    int      batch_error;           /* first transport error since the outermost begin */
+
+    /* hardware scrolling, GDDRAM is off limits while active */
+    bool     scrolling;
+    uint8_t  scroll_page_start;
+    uint8_t  scroll_page_end;
+
+#if SSD1306_STATS
+    ssd1306_stats_t stats;
+#endif
+};
+
+#define SSD1306_BATCH_NONE      SIZE_MAX
+
+/*
+ * Defines a display and its buffers with the geometry known at compile time,
+ * e.g. SSD1306_DEFINE(panel, &ssd1306_transport_default, 0x3C, 128, 64);
+ */
+#define SSD1306_DEFINE(name, bus, addr, w, h) \
+    static uint8_t  name##_vram[(w) * ((h) / 8)] __attribute__((aligned(4))); \
+    static uint8_t  name##_dirty[2][(h) / 8]; \
+    static uint16_t name##_stream[SSD1306_STREAM_WORDS(w, h)]; \
+    static uint8_t  name##_batch[SSD1306_BATCH_SIZE]; \
+    ssd1306_t name = { \
+        .transport = (bus), .address = (addr), \
+        .width = (w), .height = (h), .pages = (h) / 8, \
+        .vram = name##_vram, \
+        .dirty_start = name##_dirty[0], .dirty_stop = name##_dirty[1], \
+        .stream = name##_stream, \
+        .batch_buffer = name##_batch, .batch_run = SSD1306_BATCH_NONE, \
+    }
+
+/*
+ * Defines a display for the display list renderer (ssd1306_list_render)
+ * that only keeps one page strip in RAM, whatever the panel height. Draw
+ * calls on it do nothing and refreshes send nothing, only the display list
+ * renders to it. Only vram and the stream shrink to one page: the display
+ * still has its 16-bit stream (2 * (w + 14) bytes) and SSD1306_BATCH_SIZE
+ * batch buffer, so a 128x64 strip display takes 684 bytes of buffers
+ * against 3498 for SSD1306_DEFINE.
+ */
+#define SSD1306_DEFINE_STRIP(name, bus, addr, w, h) \
+    static uint8_t  name##_vram[(w)] __attribute__((aligned(4))); \
+    static uint8_t  name##_dirty[2][(h) / 8]; \
+    static uint16_t name##_stream[SSD1306_STREAM_WORDS(w, 8)]; \
+    static uint8_t  name##_batch[SSD1306_BATCH_SIZE]; \
+    ssd1306_t name = { \
+        .transport = (bus), .address = (addr), \
+        .width = (w), .height = (h), .pages = (h) / 8, \
+        .vram = name##_vram, .strip = true, \
+        .dirty_start = name##_dirty[0], .dirty_stop = name##_dirty[1], \
+        .stream = name##_stream, \
+        .batch_buffer = name##_batch, .batch_run = SSD1306_BATCH_NONE, \
+    }
+
+/*
+ * Runs call with W (columns) and P (pages) as compile time constants for the
+ * common panels, so the inner loops of always_inline helpers are folded, and
+ * with the runtime values for anything else.
+ */
+#define SSD1306_SPECIALISE(disp, call) \
+    do { \
+        if((disp)->width == 128 && (disp)->pages == 4)      { enum { W = 128, P = 4 }; call; } \
+        else if((disp)->width == 128 && (disp)->pages == 8) { enum { W = 128, P = 8 }; call; } \
+        else { const int W = (disp)->width, P = (disp)->pages; call; } \
+    } while(0)
+
 /* library function */
-void ssd1306_send_cmdlist(const uint8_t* list, size_t lenght);
-void ssd1306_send_data(const uint8_t* data, size_t lenght);
-void ssd1306_refresh();
-void ssd1306_init();
+int  ssd1306_send_cmdlist(ssd1306_t* disp, const uint8_t* list, size_t lenght);
+int  ssd1306_send_data(ssd1306_t* disp, const uint8_t* data, size_t lenght);
+int  ssd1306_refresh(ssd1306_t* disp);
+int  ssd1306_init(ssd1306_t* disp);
+int  ssd1306_probe(ssd1306_t* disp);
+int  ssd1306_init_splash(ssd1306_t* disp, const uint8_t* splash);
+void ssd1306_refresh_async(ssd1306_t* disp, ssd1306_callback_t callback);
+void ssd1306_refresh_async_cmd(ssd1306_t* disp, const uint8_t* cmds, size_t lenght, ssd1306_callback_t callback);
+int  ssd1306_wait(ssd1306_t* disp);
+bool ssd1306_busy(ssd1306_t* disp);
+int  ssd1306_refresh_displays(ssd1306_t* const* displays, size_t count);
+void ssd1306_send_page_async(ssd1306_t* disp, uint8_t page, const uint8_t* data);
+void ssd1306_batch_begin(ssd1306_t* disp);
+int  ssd1306_batch_end(ssd1306_t* disp);
+int  ssd1306_batch_flush(ssd1306_t* disp);
+void ssd1306_mark_dirty(ssd1306_t* disp, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end);
+
+/* counters, all zero without SSD1306_STATS */
+void ssd1306_stats_snapshot(ssd1306_t* disp, ssd1306_stats_t* stats);
+void ssd1306_stats_reset(ssd1306_t* disp);
+void ssd1306_stats_dump(ssd1306_t* disp);
+
+/*
+ * Hardware scrolling (ssd1306_scroll.c). setup takes one of the
+ * SSD1306_SCROLL_SETUP_H and _HV commands, vertical is the row offset per
+ * step of the diagonal ones. GDDRAM must not be accessed while scrolling is
+ * active, so until ssd1306_scroll_stop refreshes, page sends and console
+ * flushes are deferred (vram and the dirty ranges are kept), while
+ * ssd1306_send_data and ssd1306_stream_bitmap are refused. Stopping resends
+ * the scrolled pages from vram. ssd1306_init and ssd1306_init_splash stop
+ * scrolling themselves.
+ */
+void ssd1306_scroll_setup(ssd1306_t* disp, uint8_t direction, uint8_t page_start, uint8_t page_end,
+                          uint8_t interval, uint8_t vertical);
+void ssd1306_scroll_area(ssd1306_t* disp, uint8_t fixed_rows, uint8_t rows);
+void ssd1306_scroll_start(ssd1306_t* disp);
+void ssd1306_scroll_stop(ssd1306_t* disp);
+
+void ssd1306_draw_character(ssd1306_t* disp, uint8_t c);
+void ssd1306_fill_vram(ssd1306_t* disp, uint8_t value);
+
+/* vram drawing, nothing is sent before the next refresh (ssd1306_gfx.c) */
+void ssd1306_draw_pixel(ssd1306_t* disp, uint16_t x, uint16_t y, uint8_t value);
+void ssd1306_draw_hline(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, uint8_t color);
+void ssd1306_draw_vline(ssd1306_t* disp, int16_t x, int16_t y, int16_t h, uint8_t color);
+void ssd1306_draw_line(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
+void ssd1306_draw_rect(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+void ssd1306_fill_rect(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+void ssd1306_draw_circle(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t r, uint8_t color);
+void ssd1306_fill_circle(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t r, uint8_t color);
+
+/* vram text at any pixel position, return the x after the last glyph (ssd1306_text.c) */
+int16_t ssd1306_draw_char(ssd1306_t* disp, int16_t x, int16_t y, char c, const ssd1306_font_t* font, uint8_t color);
+int16_t ssd1306_draw_string(ssd1306_t* disp, int16_t x, int16_t y, const char* str, const ssd1306_font_t* font, uint8_t color);
+int16_t ssd1306_string_width(const char* str, const ssd1306_font_t* font);
+
+/*
+ * Compressed bitmaps (ssd1306_bitmap.c), made by tools/bitmap2c.py. Bytes
+ * are in vram layout, page major, and RLE coded: a header byte below 0x80
+ * is followed by header + 1 literal bytes, one from 0x80 up repeats the
+ * next byte header - 0x80 + 2 times. mask uses the same coding, set bits
+ * are opaque. Delta frames hold the XOR against the previous frame.
+ */
+#define SSD1306_BITMAP_DELTA        0x01
+
+typedef struct {
+    const uint8_t* data;
+    const uint8_t* mask;            /* NULL if every pixel is opaque */
+    uint8_t width;                  /* columns */
+    uint8_t pages;
+    uint8_t flags;
+} ssd1306_bitmap_t;
+
+void ssd1306_draw_bitmap(ssd1306_t* disp, int16_t x, int16_t y, const ssd1306_bitmap_t* bitmap);
+int  ssd1306_stream_bitmap(ssd1306_t* disp, uint8_t col, uint8_t page, const ssd1306_bitmap_t* bitmap);
+
+/*
+ * Display lists (ssd1306_list.c). Draw calls are recorded, then replayed
+ * once per page strip by ssd1306_list_render, which sends each strip while
+ * the next one renders. Strings and bitmaps are referenced, not copied, and
+ * must stay valid until the list is rendered. Recording returns false when
+ * the list is full.
+ */
+enum {
+    SSD1306_OP_PIXEL,
+    SSD1306_OP_LINE,
+    SSD1306_OP_RECT,
+    SSD1306_OP_FILL_RECT,
+    SSD1306_OP_CIRCLE,
+    SSD1306_OP_FILL_CIRCLE,
+    SSD1306_OP_STRING,
+    SSD1306_OP_BITMAP,
+};
+
+typedef struct {
+    uint8_t op;
+    uint8_t color;
+    int16_t x0, y0, x1, y1;         /* arguments, see ssd1306_list.c */
+    int16_t top, bottom;            /* rows touched, strips outside are skipped */
+    const void* data;               /* string or bitmap */
+    const ssd1306_font_t* font;
+} ssd1306_op_t;
+
+typedef struct {
+    ssd1306_op_t* ops;
+    uint16_t capacity;
+    uint16_t count;
+} ssd1306_list_t;
+
+void ssd1306_list_init(ssd1306_list_t* list, ssd1306_op_t* ops, uint16_t capacity);
+void ssd1306_list_clear(ssd1306_list_t* list);
+bool ssd1306_list_pixel(ssd1306_list_t* list, int16_t x, int16_t y, uint8_t color);
+bool ssd1306_list_line(ssd1306_list_t* list, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
+bool ssd1306_list_rect(ssd1306_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+bool ssd1306_list_fill_rect(ssd1306_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+bool ssd1306_list_circle(ssd1306_list_t* list, int16_t x0, int16_t y0, int16_t r, uint8_t color);
+bool ssd1306_list_fill_circle(ssd1306_list_t* list, int16_t x0, int16_t y0, int16_t r, uint8_t color);
+bool ssd1306_list_string(ssd1306_list_t* list, int16_t x, int16_t y, const char* str, const ssd1306_font_t* font, uint8_t color);
+bool ssd1306_list_bitmap(ssd1306_list_t* list, int16_t x, int16_t y, const ssd1306_bitmap_t* bitmap);
+void ssd1306_list_render(ssd1306_t* disp, const ssd1306_list_t* list);
+
+/*
+ * Text console (ssd1306_console.c). A grid of 6x8 character cells written
+ * straight to GDDRAM, bypassing vram. All 8 GDDRAM pages form a ring and
+ * scrolling moves the display start line, so a new line costs one page of
+ * changed cells plus one command. Flushing sends only the cells that changed.
+ */
+#define SSD1306_CONSOLE_MAX_COLS    (SSD1306_COLUMNS / 6)
+
+typedef struct {
+    ssd1306_t* disp;
+    uint8_t cols, rows;             /* visible cells */
+    uint8_t top;                    /* GDDRAM page of the first visible row */
+    uint8_t x, y;                   /* cursor, y is a visible row */
+    bool    start_line;             /* start line command pending */
+    char    cells[SSD1306_MAX_PAGES][SSD1306_CONSOLE_MAX_COLS];    /* by GDDRAM page */
+    char    shown[SSD1306_MAX_PAGES][SSD1306_CONSOLE_MAX_COLS];    /* what GDDRAM holds */
+} ssd1306_console_t;
+
+void ssd1306_console_init(ssd1306_console_t* con, ssd1306_t* disp);
+void ssd1306_console_clear(ssd1306_console_t* con);
+void ssd1306_console_putc(ssd1306_console_t* con, char c);
+void ssd1306_console_write(ssd1306_console_t* con, const char* str, size_t lenght);
+void ssd1306_console_flush(ssd1306_console_t* con);
+void ssd1306_console_stdio(ssd1306_console_t* con);    /* pico stdio output driver, RP2040 only */
+
+/*
+ * 2-bit grayscale (ssd1306_gray.c) by frame rate modulation. Every pixel has
+ * a level 0..3 stored in two bit-planes, each a vram laid out like the
+ * display's. ssd1306_gray_step shows the next phase of the cycle and has to
+ * be called at a fixed cadence, well over 100 Hz, for the eye to average the
+ * phases. Only the columns where the shown plane changes are sent, so
+ * pixels that are fully on or off cost nothing after the first cycle.
+ *
+ *   SSD1306_GRAY_FRAMES    3 phases, bit 1 shown twice, bit 0 once
+ *   SSD1306_GRAY_CONTRAST  2 phases, bit 0 shown at half the contrast of
+ *                          bit 1, shorter cycle and less flicker, at the
+ *                          price of a contrast command per phase, sent
+ *                          in the plane's stream
+ */
+#define SSD1306_GRAY_FRAMES     0
+#define SSD1306_GRAY_CONTRAST   1
+
+/* bytes of plane memory for ssd1306_gray_init */
+#define SSD1306_GRAY_BYTES(width, height)   (2 * (width) * ((height) / 8))
+
+typedef struct {
+    ssd1306_t* disp;
+    ssd1306_t plane[2];             /* bit 0 and bit 1 of every level, see SSD1306_GRAY_DRAW */
+    uint8_t plane_dirty[2][2][SSD1306_MAX_PAGES];
+    uint8_t mode;
+    uint8_t phase;
+    uint8_t contrast;               /* contrast of bit 1 */
+} ssd1306_gray_t;
+
+/*
+ * Runs a drawing call once per plane, with the caller named plane bound to
+ * the plane display and color to the plane's color for level:
+ *
+ *   SSD1306_GRAY_DRAW(&gray, 1, p, c, ssd1306_fill_rect(p, 0, 0, 32, 8, c));
+ */
+#define SSD1306_GRAY_DRAW(gray, level, plane, color, call) \
+    do { \
+        for(int ssd1306_gray_bit_ = 0; ssd1306_gray_bit_ < 2; ssd1306_gray_bit_++){ \
+            ssd1306_t* plane = &(gray)->plane[ssd1306_gray_bit_]; \
+            uint8_t color = ((level) >> ssd1306_gray_bit_) & 1 ? SSD1306_WHITE : SSD1306_BLACK; \
+            call; \
+        } \
+    } while(0)
 
-void ssd1306_draw_pixel(uint16_t x, uint16_t y, uint8_t value);
-void ssd1306_fill_vram(uint8_t value);
+void ssd1306_gray_init(ssd1306_gray_t* gray, ssd1306_t* disp, uint8_t* planes, uint8_t mode);
+bool ssd1306_gray_step(ssd1306_gray_t* gray);
 
 
 #endif
\ No newline at end of file
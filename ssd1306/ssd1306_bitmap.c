@@ -0,0 +1,110 @@
+
+#include "ssd1306.h"
+
+/* decoded bytes per bus chunk when streaming */
+#define SSD1306_BITMAP_CHUNK    32
+
+/* RLE decoder state, see ssd1306_bitmap_t */
+typedef struct {
+    const uint8_t* in;
+    uint8_t count;                  /* bytes left in the current run */
+    uint8_t value;
+    bool    repeat;
+} ssd1306_rle_t;
+
+static inline uint8_t ssd1306_rle_next(ssd1306_rle_t* rle){
+    if(rle->count == 0){
+        uint8_t header = *rle->in++;
+
+        rle->repeat = header & 0x80;
+        if(rle->repeat){
+            rle->count = header - 0x80 + 2;
+            rle->value = *rle->in++;
+        }
+        else
+            rle->count = header + 1;
+    }
+
+    rle->count--;
+    return rle->repeat ? rle->value : *rle->in++;
+}
+
+/* applies bits under mask to one vram byte, only changed bytes are marked dirty */
+static void ssd1306_bitmap_put(ssd1306_t* disp, int16_t col, int16_t page, uint8_t bits, uint8_t mask, bool delta){
+    uint8_t* dst;
+    uint8_t value;
+
+    if(disp->strip || page < 0 || page >= disp->pages || !mask)
+        return;
+
+    dst = &disp->vram[page * disp->width + col];
+    value = delta ? *dst ^ bits : (*dst & ~mask) | (bits & mask);
+    if(value != *dst){
+        *dst = value;
+        ssd1306_mark_dirty(disp, col, col, page, page);
+    }
+}
+
+/*
+ * Composites a bitmap into vram at any pixel position, clipped. Masked out
+ * pixels are left alone, delta frames are XORed onto the previous frame.
+ */
+void ssd1306_draw_bitmap(ssd1306_t* disp, int16_t x, int16_t y, const ssd1306_bitmap_t* bitmap){
+    ssd1306_rle_t data = { bitmap->data };
+    ssd1306_rle_t mask = { bitmap->mask };
+    bool delta = bitmap->flags & SSD1306_BITMAP_DELTA;
+    uint8_t shift = y & 0x07;
+    int16_t page0 = y >> 3;     /* floor, also for negative y */
+
+    for(int page = 0; page < bitmap->pages; page++){
+        for(int col = 0; col < bitmap->width; col++){
+            /* clipped bytes are decoded all the same to keep the streams in step */
+            uint8_t bits = ssd1306_rle_next(&data);
+            uint8_t m = bitmap->mask ? ssd1306_rle_next(&mask) : 0xFF;
+            int16_t x1 = x + col;
+
+            if(x1 < 0 || x1 >= disp->width)
+                continue;
+
+            ssd1306_bitmap_put(disp, x1, page0 + page, bits << shift, m << shift, delta);
+            if(shift)
+                ssd1306_bitmap_put(disp, x1, page0 + page + 1, bits >> (8 - shift), m >> (8 - shift), delta);
+        }
+    }
+}
+
+/*
+ * Decodes a bitmap straight into the outgoing transfer, a chunk at a time,
+ * without going through vram (which is left as it was). Only whole
+ * opaque frames at page positions can be sent this way. Masked and delta
+ * frames need the previous contents and return -1, as does a display that
+ * is scrolling. Otherwise returns 0 or the transport error.
+ */
+int ssd1306_stream_bitmap(ssd1306_t* disp, uint8_t col, uint8_t page, const ssd1306_bitmap_t* bitmap){
+    ssd1306_rle_t data = { bitmap->data };
+    uint8_t chunk[SSD1306_BITMAP_CHUNK];
+    size_t lenght = bitmap->width * bitmap->pages;
+    size_t n = 0;
+
+    if(disp->scrolling || bitmap->mask || bitmap->flags & SSD1306_BITMAP_DELTA ||
+       col + bitmap->width > disp->width || page + bitmap->pages > disp->pages)
+        return -1;
+
+    uint8_t cfg[] = {
+        SSD1306_SETPAGERANGE, page, page + bitmap->pages - 1,
+        SSD1306_SETCOLRANGE, col, col + bitmap->width - 1
+    };
+
+    /* the batch keeps the data run going across transactions */
+    ssd1306_batch_begin(disp);
+    ssd1306_send_cmdlist(disp, cfg, sizeof(cfg));
+    while(lenght--){
+        chunk[n++] = ssd1306_rle_next(&data);
+        if(n == sizeof(chunk) || lenght == 0){
+            ssd1306_send_data(disp, chunk, n);
+            n = 0;
+        }
+    }
+
+    return ssd1306_batch_end(disp);
+}
@@ -0,0 +1,151 @@
+
+#include <string.h>
+#include "ssd1306.h"
+
+#if LIB_PICO_STDIO
+#include "pico/stdio/driver.h"
+#endif
+
+/* GDDRAM always has 8 pages, whatever part of it the panel shows */
+#define SSD1306_CONSOLE_RING    SSD1306_MAX_PAGES
+
+static uint8_t ssd1306_console_page(const ssd1306_console_t* con, uint8_t row){
+    return (con->top + row) % SSD1306_CONSOLE_RING;
+}
+
+void ssd1306_console_init(ssd1306_console_t* con, ssd1306_t* disp){
+    con->disp = disp;
+    con->cols = disp->width / 6;
+    con->rows = disp->pages;
+    ssd1306_console_clear(con);
+
+    /* GDDRAM content is unknown, NUL never matches a cell */
+    memset(con->shown, 0, sizeof(con->shown));
+}
+
+void ssd1306_console_clear(ssd1306_console_t* con){
+    memset(con->cells, ' ', sizeof(con->cells));
+    con->top = 0;
+    con->x = 0;
+    con->y = 0;
+    con->start_line = true;
+}
+
+/* moves the ring one row, the row scrolled in starts out blank */
+static void ssd1306_console_newline(ssd1306_console_t* con){
+    con->x = 0;
+    if(con->y + 1 < con->rows){
+        con->y++;
+        return;
+    }
+
+    con->top = (con->top + 1) % SSD1306_CONSOLE_RING;
+    con->start_line = true;
+    memset(con->cells[ssd1306_console_page(con, con->y)], ' ', SSD1306_CONSOLE_MAX_COLS);
+}
+
+void ssd1306_console_putc(ssd1306_console_t* con, char c){
+    switch(c){
+        case '\n':
+            ssd1306_console_newline(con);
+            return;
+        case '\r':
+            con->x = 0;
+            return;
+        case '\b':
+            if(con->x)
+                con->x--;
+            return;
+        case '\t':
+            do
+                ssd1306_console_putc(con, ' ');
+            while(con->x % 4);
+            return;
+        case '\f':
+            ssd1306_console_clear(con);
+            return;
+    }
+
+    if((uint8_t)c < ' ')
+        return;
+
+    /* wrap */
+    if(con->x >= con->cols)
+        ssd1306_console_newline(con);
+
+    con->cells[ssd1306_console_page(con, con->y)][con->x++] = c;
+}
+
+void ssd1306_console_write(ssd1306_console_t* con, const char* str, size_t lenght){
+    while(lenght--)
+        ssd1306_console_putc(con, *str++);
+}
+
+/* sends the changed cells of every visible row, one window per row, all in one batch */
+void ssd1306_console_flush(ssd1306_console_t* con){
+    ssd1306_t* disp = con->disp;
+
+    /* deferred, the changed cells are still pending once scrolling stops */
+    if(disp->scrolling)
+        return;
+
+    ssd1306_batch_begin(disp);
+
+    if(con->start_line){
+        uint8_t cmd = SSD1306_SETSTARTLINE | (con->top * 8);
+        ssd1306_send_cmdlist(disp, &cmd, 1);
+        con->start_line = false;
+    }
+
+    for(int row = 0; row < con->rows; row++){
+        uint8_t page = ssd1306_console_page(con, row);
+        const char* cells = con->cells[page];
+        char* shown = con->shown[page];
+        int first = 0, last = con->cols - 1;
+
+        while(first <= last && cells[first] == shown[first])
+            first++;
+        while(last >= first && cells[last] == shown[last])
+            last--;
+        if(first > last)
+            continue;
+
+        uint8_t cfg[] = {
+            SSD1306_SETPAGERANGE, page, page,
+            SSD1306_SETCOLRANGE, first * 6, last * 6 + 5
+        };
+        ssd1306_send_cmdlist(disp, cfg, sizeof(cfg));
+
+        for(int col = first; col <= last; col++){
+            uint8_t index = (uint8_t)cells[col] - ssd1306_font_6x8.first;
+            ssd1306_send_data(disp, ssd1306_font6x8[index < ssd1306_font_6x8.count ? index : 0], 6);
+            shown[col] = cells[col];
+        }
+    }
+
+    ssd1306_batch_end(disp);
+}
+
+#if LIB_PICO_STDIO
+static ssd1306_console_t* ssd1306_console_stdio_target;
+
+static void ssd1306_console_out_chars(const char* buf, int len){
+    ssd1306_console_write(ssd1306_console_stdio_target, buf, len);
+    ssd1306_console_flush(ssd1306_console_stdio_target);
+}
+
+static void ssd1306_console_out_flush(void){
+    ssd1306_console_flush(ssd1306_console_stdio_target);
+}
+
+static stdio_driver_t ssd1306_console_driver = {
+    .out_chars = ssd1306_console_out_chars,
+    .out_flush = ssd1306_console_out_flush,
+};
+
+/* adds the console to the stdio outputs, printf then also goes to the panel */
+void ssd1306_console_stdio(ssd1306_console_t* con){
+    ssd1306_console_stdio_target = con;
+    stdio_set_driver_enabled(&ssd1306_console_driver, true);
+}
+#endif
@@ -0,0 +1,151 @@
+
+#include <string.h>
+#include "ssd1306_core1.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+#define SSD1306_CORE1_VRAM      (SSD1306_MAX_PAGES * SSD1306_COLUMNS)
+
+/*
+ * One queued frame. seq is a per slot seqlock: 2 * frame + 1 while core0
+ * writes the slot, 2 * frame + 2 once it is complete, so core1 can tell when
+ * a slot was overwritten while it was copying it.
+ */
+typedef struct {
+    volatile uint32_t seq;
+    uint8_t dirty_start[SSD1306_MAX_PAGES];
+    uint8_t dirty_stop[SSD1306_MAX_PAGES];
+    uint8_t vram[SSD1306_CORE1_VRAM] __attribute__((aligned(4)));
+} ssd1306_core1_slot_t;
+
+static ssd1306_core1_slot_t ssd1306_core1_slots[SSD1306_CORE1_QUEUE_DEPTH];
+
+/* every counter has a single writer, head and submitted core0, the rest core1 */
+static volatile uint32_t ssd1306_core1_head;
+static volatile uint32_t ssd1306_core1_tail;
+static volatile uint32_t ssd1306_core1_sent;
+static volatile uint32_t ssd1306_core1_dropped;
+
+/* the display core1 sends from, same bus and geometry as the one core0 draws into */
+static uint8_t ssd1306_core1_vram[SSD1306_CORE1_VRAM] __attribute__((aligned(4)));
+static uint8_t ssd1306_core1_dirty[2][SSD1306_MAX_PAGES];
+static uint8_t ssd1306_core1_batch[SSD1306_BATCH_SIZE];
+static ssd1306_t ssd1306_core1_output;
+
+/* copies the frame at tail into the output display, false if core0 overwrote it meanwhile */
+static bool ssd1306_core1_take(uint32_t tail){
+    ssd1306_core1_slot_t* slot = &ssd1306_core1_slots[tail % SSD1306_CORE1_QUEUE_DEPTH];
+    ssd1306_t* out = &ssd1306_core1_output;
+    uint32_t seq = slot->seq;
+
+    if(seq != 2 * tail + 2)
+        return false;
+
+    __dmb();
+    memcpy(out->vram, slot->vram, out->width * out->pages);
+    for(int page = 0; page < out->pages; page++){
+        if(slot->dirty_start[page] < out->dirty_start[page]) out->dirty_start[page] = slot->dirty_start[page];
+        if(slot->dirty_stop[page] > out->dirty_stop[page]) out->dirty_stop[page] = slot->dirty_stop[page];
+    }
+    __dmb();
+
+    return slot->seq == seq;
+}
+
+static void ssd1306_core1_main(){
+    ssd1306_t* out = &ssd1306_core1_output;
+
+    while(1){
+        /* sleep until core0 rings, several rings are one wakeup */
+        multicore_fifo_pop_blocking();
+        while(multicore_fifo_rvalid())
+            (void)multicore_fifo_pop_blocking();
+
+        while(ssd1306_core1_tail != ssd1306_core1_head){
+            uint32_t head = ssd1306_core1_head;
+            uint32_t tail = ssd1306_core1_tail;
+            bool resync = false;
+
+            /* the oldest frames were overwritten */
+            if(head - tail > SSD1306_CORE1_QUEUE_DEPTH){
+                ssd1306_core1_dropped += head - tail - SSD1306_CORE1_QUEUE_DEPTH;
+                tail = head - SSD1306_CORE1_QUEUE_DEPTH;
+                resync = true;
+            }
+
+            while(!ssd1306_core1_take(tail)){
+                /* overwritten while copying, skip to the oldest frame core0 is not writing over */
+                uint32_t next = ssd1306_core1_head - SSD1306_CORE1_QUEUE_DEPTH + 1;
+
+                if((int32_t)(next - tail) < 1)
+                    next = tail + 1;
+                ssd1306_core1_dropped += next - tail;
+                tail = next;
+                resync = true;
+            }
+            ssd1306_core1_tail = tail + 1;
+
+            /* changes of dropped frames are only in vram now, send all of it */
+            if(resync)
+                ssd1306_mark_dirty(out, 0, out->width - 1, 0, out->pages - 1);
+
+            ssd1306_refresh(out);
+            ssd1306_core1_sent++;
+        }
+    }
+}
+
+void ssd1306_core1_start(ssd1306_t* disp){
+    ssd1306_t* out = &ssd1306_core1_output;
+
+    ssd1306_batch_flush(disp);
+    ssd1306_wait(disp);
+
+    *out = (ssd1306_t){
+        .transport = disp->transport, .address = disp->address,
+        .width = disp->width, .height = disp->height, .pages = disp->pages,
+        .vram = ssd1306_core1_vram,
+        .dirty_start = ssd1306_core1_dirty[0], .dirty_stop = ssd1306_core1_dirty[1],
+        .batch_buffer = ssd1306_core1_batch, .batch_run = SSD1306_BATCH_NONE,
+    };
+    memset(out->dirty_start, out->width, out->pages);
+    memset(out->dirty_stop, 0, out->pages);
+
+    multicore_launch_core1(ssd1306_core1_main);
+}
+
+bool ssd1306_core1_submit(ssd1306_t* disp){
+    uint32_t head = ssd1306_core1_head;
+    ssd1306_core1_slot_t* slot = &ssd1306_core1_slots[head % SSD1306_CORE1_QUEUE_DEPTH];
+    bool full = head - ssd1306_core1_tail >= SSD1306_CORE1_QUEUE_DEPTH;
+
+    slot->seq = 2 * head + 1;
+    __dmb();
+    memcpy(slot->vram, disp->vram, disp->width * disp->pages);
+    memcpy(slot->dirty_start, disp->dirty_start, disp->pages);
+    memcpy(slot->dirty_stop, disp->dirty_stop, disp->pages);
+    __dmb();
+    slot->seq = 2 * head + 2;
+    __dmb();
+    ssd1306_core1_head = head + 1;
+
+    memset(disp->dirty_start, disp->width, disp->pages);
+    memset(disp->dirty_stop, 0, disp->pages);
+
+    /* wake core1, if the FIFO is full it has rings pending anyway */
+    if(multicore_fifo_wready())
+        multicore_fifo_push_blocking(head + 1);
+
+    return !full;
+}
+
+void ssd1306_core1_stats(ssd1306_core1_stats_t* stats){
+    uint32_t head = ssd1306_core1_head;
+    uint32_t depth = head - ssd1306_core1_tail;
+
+    stats->submitted = head;
+    stats->sent = ssd1306_core1_sent;
+    stats->dropped = ssd1306_core1_dropped;
+    stats->depth = depth > SSD1306_CORE1_QUEUE_DEPTH ? SSD1306_CORE1_QUEUE_DEPTH : depth;
+}
@@ -0,0 +1,33 @@
+#ifndef SSD1306_CORE1_H
+#define SSD1306_CORE1_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+/*
+ * RP2040 dual core pipeline. Core0 draws into the display vram and submits
+ * finished frames, core1 owns the bus and sends them. Frames go through a
+ * lock-free single producer / single consumer ring, the multicore FIFO only
+ * wakes core1 up. When core1 falls behind the oldest queued frame is
+ * overwritten, so submitting never blocks core0.
+ */
+
+#define SSD1306_CORE1_QUEUE_DEPTH   4       /* frames queued for core1 */
+
+typedef struct {
+    uint32_t submitted;             /* frames handed over by core0 */
+    uint32_t sent;                  /* frames sent by core1 */
+    uint32_t dropped;               /* frames overwritten before core1 got to them */
+    uint32_t depth;                 /* frames currently queued */
+} ssd1306_core1_stats_t;
+
+/* launches core1 for disp, the display must be initialised, core0 stops using its bus */
+void ssd1306_core1_start(ssd1306_t* disp);
+
+/* snapshots vram and its dirty ranges into the queue and clears them, returns false if a frame was dropped */
+bool ssd1306_core1_submit(ssd1306_t* disp);
+
+void ssd1306_core1_stats(ssd1306_core1_stats_t* stats);
+
+#endif
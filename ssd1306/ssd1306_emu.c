@@ -0,0 +1,404 @@
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306_emu.h"
+
+/* control byte bits */
+#define SSD1306_EMU_CO      0x80    /* continuation: one byte follows, then another control byte */
+#define SSD1306_EMU_DC      0x40    /* following bytes are data */
+
+/* decoder states within one transaction */
+enum {
+    SSD1306_EMU_CTRL,               /* next byte is a control byte */
+    SSD1306_EMU_ONE_CMD,            /* next byte is a single command byte */
+    SSD1306_EMU_ONE_DATA,           /* next byte is a single data byte */
+    SSD1306_EMU_CMDS,               /* rest of the transaction are commands */
+    SSD1306_EMU_DATA,               /* rest of the transaction is data */
+};
+
+/* scroll step interval in frames, indexed by the 3-bit setting */
+static const uint16_t ssd1306_emu_intervals[8] = { 5, 64, 128, 256, 3, 4, 25, 2 };
+
+/* default instance answers at SSD1306_ADDRESS, reset state at 400 kHz like the demo */
+ssd1306_emu_t ssd1306_emu = {
+    .address = SSD1306_ADDRESS,
+    .bus_hz = 400000,
+    .address_mode = 2,
+    .col_end = SSD1306_EMU_COLUMNS - 1,
+    .page_end = SSD1306_EMU_PAGES - 1,
+    .multiplex = 63,
+    .contrast = 0x7F,
+    .scroll_interval = 5,
+    .scroll_area_rows = 64,
+};
+
+void ssd1306_emu_reset_stats(ssd1306_emu_t* emu){
+    emu->bus_bits = 0;
+    emu->transactions = 0;
+    emu->bytes = 0;
+    emu->cmd_bytes = 0;
+    emu->data_bytes = 0;
+    emu->bus_time_ns = 0;
+}
+
+/* power-on reset values from the datasheet */
+void ssd1306_emu_reset(ssd1306_emu_t* emu, uint8_t address, uint32_t bus_hz){
+    memset(emu, 0, sizeof(*emu));
+    emu->address = address;
+    emu->bus_hz = bus_hz;
+    emu->address_mode = 2;
+    emu->col_end = SSD1306_EMU_COLUMNS - 1;
+    emu->page_end = SSD1306_EMU_PAGES - 1;
+    emu->multiplex = 63;
+    emu->contrast = 0x7F;
+    emu->scroll_interval = ssd1306_emu_intervals[0];
+    emu->scroll_area_rows = 64;
+}
+
+static int ssd1306_emu_cmd_args(uint8_t cmd){
+    switch(cmd){
+        case SSD1306_SETCONTRAST:
+        case SSD1306_SETADDRESSMODE:
+        case SSD1306_SETMULTIPLEX:
+        case SSD1306_VERTICALOFFSET:
+        case SSD1306_SETCOMPINS:
+        case SSD1306_SETDISPLAYCLOCKDIV:
+        case SSD1306_SETPRECHARGE:
+        case SSD1306_SETVCOMLEVEL:
+        case SSD1306_SETCHARGEPUMP:
+            return 1;
+        case SSD1306_SETCOLRANGE:
+        case SSD1306_SETPAGERANGE:
+        case SSD1306_SCROLL_SETUP_V:
+            return 2;
+        case SSD1306_SCROLL_SETUP_HV_RIGHT:
+        case SSD1306_SCROLL_SETUP_HV_LEFT:
+            return 5;
+        case SSD1306_SCROLL_SETUP_H_RIGHT:
+        case SSD1306_SCROLL_SETUP_H_LEFT:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void ssd1306_emu_execute(ssd1306_emu_t* emu){
+    const uint8_t* cmd = emu->cmd;
+
+    switch(cmd[0]){
+        case SSD1306_SETCONTRAST:        emu->contrast = cmd[1]; return;
+        case SSD1306_ENTIREDISPLAY_ON:   emu->entire_on = true; return;
+        case SSD1306_ENTIREDISPLAY_OFF:  emu->entire_on = false; return;
+        case SSD1306_SETINVERT_ON:       emu->inverted = true; return;
+        case SSD1306_SETINVERT_OFF:      emu->inverted = false; return;
+        case SSD1306_SETDISPLAY_ON:      emu->display_on = true; return;
+        case SSD1306_SETDISPLAY_OFF:     emu->display_on = false; return;
+        case SSD1306_SETADDRESSMODE:     emu->address_mode = cmd[1] & 0x03; return;
+        case SSD1306_COLSCAN_ASCENDING:  emu->seg_remap = false; return;
+        case SSD1306_COLSCAN_DESCENDING: emu->seg_remap = true; return;
+        case SSD1306_SETMULTIPLEX:       emu->multiplex = cmd[1] & 0x3F; return;
+        case SSD1306_COMSCAN_ASCENDING:  emu->com_remap = false; return;
+        case SSD1306_COMSCAN_DESCENDING: emu->com_remap = true; return;
+        case SSD1306_VERTICALOFFSET:     emu->vertical_offset = cmd[1] & 0x3F; return;
+
+        case SSD1306_SETCOLRANGE:
+            emu->col_start = emu->col = cmd[1] & 0x7F;
+            emu->col_end = cmd[2] & 0x7F;
+            return;
+
+        case SSD1306_SETPAGERANGE:
+            emu->page_start = emu->page = cmd[1] & 0x07;
+            emu->page_end = cmd[2] & 0x07;
+            return;
+
+        case SSD1306_SCROLL_SETUP_H_RIGHT:
+        case SSD1306_SCROLL_SETUP_H_LEFT:
+        case SSD1306_SCROLL_SETUP_HV_RIGHT:
+        case SSD1306_SCROLL_SETUP_HV_LEFT:
+            emu->scroll_setup = cmd[0];
+            emu->scroll_page_start = cmd[2] & 0x07;
+            emu->scroll_interval = ssd1306_emu_intervals[cmd[3] & 0x07];
+            emu->scroll_page_end = cmd[4] & 0x07;
+            emu->scroll_vertical = (cmd[0] == SSD1306_SCROLL_SETUP_HV_RIGHT || cmd[0] == SSD1306_SCROLL_SETUP_HV_LEFT)
+                                   ? cmd[5] & 0x3F : 0;
+            return;
+
+        case SSD1306_SCROLL_SETUP_V:
+            emu->scroll_fixed_rows = cmd[1] & 0x3F;
+            emu->scroll_area_rows = cmd[2] & 0x7F;
+            return;
+
+        case SSD1306_SCROLL_ACTIVATE:
+            emu->scroll_active = true;
+            emu->scroll_frame = 0;
+            return;
+
+        case SSD1306_SCROLL_DEACTIVATE:
+            emu->scroll_active = false;
+            emu->scroll_row = 0;
+            return;
+    }
+
+    if(cmd[0] <= 0x0F)                  /* page mode column, lower nibble */
+        emu->col = (emu->col & 0xF0) | (cmd[0] & 0x0F);
+    else if(cmd[0] <= 0x1F)             /* page mode column, upper nibble */
+        emu->col = ((cmd[0] & 0x07) << 4) | (emu->col & 0x0F);
+    else if(cmd[0] >= SSD1306_SETSTARTLINE && cmd[0] <= (SSD1306_SETSTARTLINE | 0x3F))
+        emu->start_line = cmd[0] & 0x3F;
+    else if(cmd[0] >= SSD1306_PAGE_PAGESTART && cmd[0] <= (SSD1306_PAGE_PAGESTART | 0x07))
+        emu->page = cmd[0] & 0x07;
+    /* timing, charge pump, COM pins and NOP have no visible effect */
+}
+
+static void ssd1306_emu_command(ssd1306_emu_t* emu, uint8_t byte){
+    emu->cmd[emu->cmd_len++] = byte;
+    emu->cmd_bytes++;
+
+    if(emu->cmd_len > ssd1306_emu_cmd_args(emu->cmd[0])){
+        ssd1306_emu_execute(emu);
+        emu->cmd_len = 0;
+    }
+}
+
+/* writes one byte at the GDDRAM pointer and advances it like the controller does */
+static void ssd1306_emu_data(ssd1306_emu_t* emu, uint8_t byte){
+    emu->gddram[emu->page & 0x07][emu->col & 0x7F] = byte;
+    emu->data_bytes++;
+
+    switch(emu->address_mode){
+        case 0: /* horizontal */
+            if(emu->col++ >= emu->col_end){
+                emu->col = emu->col_start;
+                emu->page = emu->page >= emu->page_end ? emu->page_start : emu->page + 1;
+            }
+            break;
+        case 1: /* vertical */
+            if(emu->page++ >= emu->page_end){
+                emu->page = emu->page_start;
+                emu->col = emu->col >= emu->col_end ? emu->col_start : emu->col + 1;
+            }
+            break;
+        default: /* page, column wraps within the page */
+            emu->col = (emu->col + 1) & 0x7F;
+            break;
+    }
+}
+
+/* START and address + R/W with its ACK, returns false on NACK */
+static bool ssd1306_emu_begin(ssd1306_emu_t* emu, uint8_t address){
+    emu->transactions++;
+    emu->bytes++;
+    emu->bus_bits += 1 + 9;
+    emu->state = SSD1306_EMU_CTRL;
+    emu->acked = address == emu->address;
+    return emu->acked;
+}
+
+/* one byte after the address, 9 clocks including ACK */
+static void ssd1306_emu_byte(ssd1306_emu_t* emu, uint8_t byte){
+    emu->bytes++;
+    emu->bus_bits += 9;
+
+    switch(emu->state){
+        case SSD1306_EMU_CTRL:
+            if(byte & SSD1306_EMU_CO)
+                emu->state = (byte & SSD1306_EMU_DC) ? SSD1306_EMU_ONE_DATA : SSD1306_EMU_ONE_CMD;
+            else
+                emu->state = (byte & SSD1306_EMU_DC) ? SSD1306_EMU_DATA : SSD1306_EMU_CMDS;
+            break;
+        case SSD1306_EMU_ONE_CMD:
+            ssd1306_emu_command(emu, byte);
+            emu->state = SSD1306_EMU_CTRL;
+            break;
+        case SSD1306_EMU_ONE_DATA:
+            ssd1306_emu_data(emu, byte);
+            emu->state = SSD1306_EMU_CTRL;
+            break;
+        case SSD1306_EMU_CMDS:
+            ssd1306_emu_command(emu, byte);
+            break;
+        case SSD1306_EMU_DATA:
+            ssd1306_emu_data(emu, byte);
+            break;
+    }
+}
+
+/* STOP */
+static void ssd1306_emu_end(ssd1306_emu_t* emu){
+    emu->bus_bits += 1;
+    if(emu->bus_hz)
+        emu->bus_time_ns = emu->bus_bits * 1000000000ull / emu->bus_hz;
+}
+
+/* decodes one transaction, returns the number of bytes written or -1 on NACK */
+int ssd1306_emu_write(ssd1306_emu_t* emu, uint8_t address, const uint8_t* data, size_t lenght){
+    if(!ssd1306_emu_begin(emu, address)){
+        ssd1306_emu_end(emu);
+        return -1;
+    }
+
+    for(size_t i = 0; i < lenght; i++)
+        ssd1306_emu_byte(emu, data[i]);
+
+    ssd1306_emu_end(emu);
+    return lenght;
+}
+
+/* advances the scroll engine by a number of display frames */
+void ssd1306_emu_tick(ssd1306_emu_t* emu, uint32_t frames){
+    bool left = emu->scroll_setup == SSD1306_SCROLL_SETUP_H_LEFT || emu->scroll_setup == SSD1306_SCROLL_SETUP_HV_LEFT;
+
+    while(emu->scroll_active && frames--){
+        if(++emu->scroll_frame % emu->scroll_interval)
+            continue;
+
+        /* horizontal scrolling really moves the GDDRAM contents */
+        for(int page = emu->scroll_page_start; page <= emu->scroll_page_end; page++){
+            uint8_t* row = emu->gddram[page];
+            if(left){
+                uint8_t first = row[0];
+                memmove(row, row + 1, SSD1306_EMU_COLUMNS - 1);
+                row[SSD1306_EMU_COLUMNS - 1] = first;
+            }
+            else{
+                uint8_t last = row[SSD1306_EMU_COLUMNS - 1];
+                memmove(row + 1, row, SSD1306_EMU_COLUMNS - 1);
+                row[0] = last;
+            }
+        }
+
+        if(emu->scroll_vertical && emu->scroll_area_rows)
+            emu->scroll_row = (emu->scroll_row + emu->scroll_vertical) % emu->scroll_area_rows;
+    }
+}
+
+/* state of a visible pixel, x in 0..127 and y in 0..multiplex */
+bool ssd1306_emu_pixel(const ssd1306_emu_t* emu, int x, int y){
+    int row, col;
+
+    if(!emu->display_on)
+        return false;
+    if(emu->entire_on)
+        return true;
+
+    row = emu->com_remap ? emu->multiplex - y : y;
+    if(emu->scroll_active && row >= emu->scroll_fixed_rows && row < emu->scroll_fixed_rows + emu->scroll_area_rows)
+        row = emu->scroll_fixed_rows + (row - emu->scroll_fixed_rows + emu->scroll_row) % emu->scroll_area_rows;
+    row = (row + emu->start_line + emu->vertical_offset) & 0x3F;
+    col = emu->seg_remap ? SSD1306_EMU_COLUMNS - 1 - x : x;
+
+    return ((emu->gddram[row >> 3][col] >> (row & 0x07)) & 1) ^ emu->inverted;
+}
+
+/*
+ * Dumps the visible panel as binary PBM, lit pixels are black. x is the
+ * panel position, so with SEG remap (A1) it runs opposite to the vram
+ * columns.
+ */
+int ssd1306_emu_write_pbm(const ssd1306_emu_t* emu, const char* path){
+    FILE* file = fopen(path, "wb");
+    int rows = emu->multiplex + 1;
+
+    if(!file)
+        return -1;
+
+    fprintf(file, "P4\n%d %d\n", SSD1306_EMU_COLUMNS, rows);
+    for(int y = 0; y < rows; y++){
+        uint8_t line[SSD1306_EMU_COLUMNS / 8] = { 0 };
+        for(int x = 0; x < SSD1306_EMU_COLUMNS; x++)
+            if(ssd1306_emu_pixel(emu, x, y))
+                line[x >> 3] |= 0x80 >> (x & 0x07);
+        fwrite(line, 1, sizeof(line), file);
+    }
+
+    return fclose(file);
+}
+
+/* transport glue */
+
+static int ssd1306_emu_transport_write(void* context, uint8_t address, const ssd1306_segment_t* segments, size_t count){
+    ssd1306_emu_t* emu = (ssd1306_emu_t*)context;
+    int lenght = 0;
+
+    if(!ssd1306_emu_begin(emu, address)){
+        ssd1306_emu_end(emu);
+        return -1;
+    }
+
+    for(size_t i = 0; i < count; i++){
+        for(size_t j = 0; j < segments[i].lenght; j++)
+            ssd1306_emu_byte(emu, segments[i].data[j]);
+        lenght += segments[i].lenght;
+    }
+
+    ssd1306_emu_end(emu);
+    return lenght;
+}
+
+/* splits the word stream at its STOP flags, completes synchronously */
+static void ssd1306_emu_transport_write_stream(void* context, uint8_t address, const uint16_t* stream, size_t count,
+                                               ssd1306_done_t done, void* arg){
+    ssd1306_emu_t* emu = (ssd1306_emu_t*)context;
+    bool started = false;
+
+    for(size_t i = 0; i < count; i++){
+        if(!started){
+            if(!ssd1306_emu_begin(emu, address))
+                emu->stream_error = true;
+            started = true;
+        }
+        if(emu->acked)
+            ssd1306_emu_byte(emu, stream[i] & 0xFF);
+        if(stream[i] & SSD1306_STREAM_STOP){
+            ssd1306_emu_end(emu);
+            started = false;
+        }
+    }
+    if(started)
+        ssd1306_emu_end(emu);
+
+    if(done)
+        done(arg);
+}
+
+static bool ssd1306_emu_transport_busy(void* context){
+    (void)context;
+    return false;
+}
+
+/* reports NACKed stream transactions once, like a cleared abort */
+static int ssd1306_emu_transport_wait(void* context){
+    ssd1306_emu_t* emu = (ssd1306_emu_t*)context;
+    bool error = emu->stream_error;
+
+    emu->stream_error = false;
+    return error ? -1 : 0;
+}
+
+ssd1306_transport_t ssd1306_emu_transport(ssd1306_emu_t* emu){
+    ssd1306_transport_t transport = {
+        .context = emu,
+        .write = ssd1306_emu_transport_write,
+        .write_stream = ssd1306_emu_transport_write_stream,
+        .busy = ssd1306_emu_transport_busy,
+        .wait = ssd1306_emu_transport_wait,
+    };
+    return transport;
+}
+
+uint64_t ssd1306_time_us(void){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/* on the host the driver talks to ssd1306_emu */
+const ssd1306_transport_t ssd1306_transport_default = {
+    .context = &ssd1306_emu,
+    .write = ssd1306_emu_transport_write,
+    .write_stream = ssd1306_emu_transport_write_stream,
+    .busy = ssd1306_emu_transport_busy,
+    .wait = ssd1306_emu_transport_wait,
+};
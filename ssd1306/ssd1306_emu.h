@@ -0,0 +1,78 @@
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+/*
+ * Host side SSD1306 emulator. Decodes the control byte / command stream of
+ * every transaction into an emulated 128x64 GDDRAM and keeps bus statistics,
+ * so the driver can be tested and measured without a Pico and a panel.
+ */
+
+#define SSD1306_EMU_COLUMNS     128
+#define SSD1306_EMU_PAGES       8
+
+typedef struct {
+    uint8_t  address;               /* 7-bit slave address, other addresses NACK */
+    uint32_t bus_hz;                /* modeled SCL frequency */
+
+    uint8_t  gddram[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS];
+
+    /* addressing */
+    uint8_t  address_mode;          /* 0 horizontal, 1 vertical, 2 page */
+    uint8_t  col_start, col_end;
+    uint8_t  page_start, page_end;
+    uint8_t  col, page;             /* GDDRAM pointer */
+
+    /* hardware configuration */
+    uint8_t  start_line;
+    uint8_t  multiplex;             /* rows - 1 */
+    uint8_t  vertical_offset;
+    uint8_t  contrast;
+    bool     seg_remap;
+    bool     com_remap;
+    bool     display_on;
+    bool     inverted;
+    bool     entire_on;
+
+    /* scrolling */
+    uint8_t  scroll_setup;          /* last SSD1306_SCROLL_SETUP_* command */
+    uint8_t  scroll_page_start, scroll_page_end;
+    uint16_t scroll_interval;       /* in frames */
+    uint8_t  scroll_vertical;       /* rows per step for diagonal scrolling */
+    uint8_t  scroll_fixed_rows, scroll_area_rows;
+    uint8_t  scroll_row;            /* current vertical scroll position */
+    uint32_t scroll_frame;
+    bool     scroll_active;
+
+    /* transaction decoder state */
+    uint8_t  state;
+    bool     acked;
+    bool     stream_error;          /* a streamed transaction was NACKed, cleared by wait */
+    uint8_t  cmd[8];
+    uint8_t  cmd_len;
+
+    /* bus statistics */
+    uint64_t transactions;
+    uint64_t bytes;                 /* including address and control bytes */
+    uint64_t cmd_bytes;
+    uint64_t data_bytes;
+    uint64_t bus_bits;              /* SCL clocks including START/STOP */
+    uint64_t bus_time_ns;
+} ssd1306_emu_t;
+
+/* emulator instance behind ssd1306_transport_default on the host */
+extern ssd1306_emu_t ssd1306_emu;
+
+void ssd1306_emu_reset(ssd1306_emu_t* emu, uint8_t address, uint32_t bus_hz);
+void ssd1306_emu_reset_stats(ssd1306_emu_t* emu);
+int  ssd1306_emu_write(ssd1306_emu_t* emu, uint8_t address, const uint8_t* data, size_t lenght);
+void ssd1306_emu_tick(ssd1306_emu_t* emu, uint32_t frames);
+bool ssd1306_emu_pixel(const ssd1306_emu_t* emu, int x, int y);
+int  ssd1306_emu_write_pbm(const ssd1306_emu_t* emu, const char* path);    /* panel view, see ssd1306_emu.c */
+ssd1306_transport_t ssd1306_emu_transport(ssd1306_emu_t* emu);
+
+#endif
@@ -0,0 +1,194 @@
+
+#include "ssd1306.h"
+
+/*
+ * 6x8 font designed for ssd1306, one byte per column with the LSB on top.
+ * Kept as an X-macro list so the proportional and scaled variants below are
+ * generated from the same data by the compiler.
+ */
+#define SSD1306_FONT6X8_GLYPHS(G) \
+    G(0x00, 0x00, 0x00, 0x00, 0x00, 0x00) /* sp */ \
+    G(0x00, 0x00, 0x00, 0x2f, 0x00, 0x00) /* ! */ \
+    G(0x00, 0x00, 0x07, 0x00, 0x07, 0x00) /* " */ \
+    G(0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14) /* # */ \
+    G(0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12) /* $ */ \
+    G(0x00, 0x23, 0x13, 0x08, 0x64, 0x62) /* % */ \
+    G(0x00, 0x36, 0x49, 0x55, 0x22, 0x50) /* & */ \
+    G(0x00, 0x00, 0x05, 0x03, 0x00, 0x00) /* ' */ \
+    G(0x00, 0x00, 0x1c, 0x22, 0x41, 0x00) /* ( */ \
+    G(0x00, 0x00, 0x41, 0x22, 0x1c, 0x00) /* ) */ \
+    G(0x00, 0x14, 0x08, 0x3E, 0x08, 0x14) /* * */ \
+    G(0x00, 0x08, 0x08, 0x3E, 0x08, 0x08) /* + */ \
+    G(0x00, 0x00, 0x00, 0xA0, 0x60, 0x00) /* , */ \
+    G(0x00, 0x08, 0x08, 0x08, 0x08, 0x08) /* - */ \
+    G(0x00, 0x00, 0x60, 0x60, 0x00, 0x00) /* . */ \
+    G(0x00, 0x20, 0x10, 0x08, 0x04, 0x02) /* / */ \
+    G(0x00, 0x3E, 0x51, 0x49, 0x45, 0x3E) /* 0 */ \
+    G(0x00, 0x00, 0x42, 0x7F, 0x40, 0x00) /* 1 */ \
+    G(0x00, 0x42, 0x61, 0x51, 0x49, 0x46) /* 2 */ \
+    G(0x00, 0x21, 0x41, 0x45, 0x4B, 0x31) /* 3 */ \
+    G(0x00, 0x18, 0x14, 0x12, 0x7F, 0x10) /* 4 */ \
+    G(0x00, 0x27, 0x45, 0x45, 0x45, 0x39) /* 5 */ \
+    G(0x00, 0x3C, 0x4A, 0x49, 0x49, 0x30) /* 6 */ \
+    G(0x00, 0x01, 0x71, 0x09, 0x05, 0x03) /* 7 */ \
+    G(0x00, 0x36, 0x49, 0x49, 0x49, 0x36) /* 8 */ \
+    G(0x00, 0x06, 0x49, 0x49, 0x29, 0x1E) /* 9 */ \
+    G(0x00, 0x00, 0x36, 0x36, 0x00, 0x00) /* : */ \
+    G(0x00, 0x00, 0x56, 0x36, 0x00, 0x00) /* ; */ \
+    G(0x00, 0x08, 0x14, 0x22, 0x41, 0x00) /* < */ \
+    G(0x00, 0x14, 0x14, 0x14, 0x14, 0x14) /* = */ \
+    G(0x00, 0x00, 0x41, 0x22, 0x14, 0x08) /* > */ \
+    G(0x00, 0x02, 0x01, 0x51, 0x09, 0x06) /* ? */ \
+    G(0x00, 0x32, 0x49, 0x59, 0x51, 0x3E) /* @ */ \
+    G(0x00, 0x7C, 0x12, 0x11, 0x12, 0x7C) /* A */ \
+    G(0x00, 0x7F, 0x49, 0x49, 0x49, 0x36) /* B */ \
+    G(0x00, 0x3E, 0x41, 0x41, 0x41, 0x22) /* C */ \
+    G(0x00, 0x7F, 0x41, 0x41, 0x22, 0x1C) /* D */ \
+    G(0x00, 0x7F, 0x49, 0x49, 0x49, 0x41) /* E */ \
+    G(0x00, 0x7F, 0x09, 0x09, 0x09, 0x01) /* F */ \
+    G(0x00, 0x3E, 0x41, 0x49, 0x49, 0x7A) /* G */ \
+    G(0x00, 0x7F, 0x08, 0x08, 0x08, 0x7F) /* H */ \
+    G(0x00, 0x00, 0x41, 0x7F, 0x41, 0x00) /* I */ \
+    G(0x00, 0x20, 0x40, 0x41, 0x3F, 0x01) /* J */ \
+    G(0x00, 0x7F, 0x08, 0x14, 0x22, 0x41) /* K */ \
+    G(0x00, 0x7F, 0x40, 0x40, 0x40, 0x40) /* L */ \
+    G(0x00, 0x7F, 0x02, 0x0C, 0x02, 0x7F) /* M */ \
+    G(0x00, 0x7F, 0x04, 0x08, 0x10, 0x7F) /* N */ \
+    G(0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E) /* O */ \
+    G(0x00, 0x7F, 0x09, 0x09, 0x09, 0x06) /* P */ \
+    G(0x00, 0x3E, 0x41, 0x51, 0x21, 0x5E) /* Q */ \
+    G(0x00, 0x7F, 0x09, 0x19, 0x29, 0x46) /* R */ \
+    G(0x00, 0x46, 0x49, 0x49, 0x49, 0x31) /* S */ \
+    G(0x00, 0x01, 0x01, 0x7F, 0x01, 0x01) /* T */ \
+    G(0x00, 0x3F, 0x40, 0x40, 0x40, 0x3F) /* U */ \
+    G(0x00, 0x1F, 0x20, 0x40, 0x20, 0x1F) /* V */ \
+    G(0x00, 0x3F, 0x40, 0x38, 0x40, 0x3F) /* W */ \
+    G(0x00, 0x63, 0x14, 0x08, 0x14, 0x63) /* X */ \
+    G(0x00, 0x07, 0x08, 0x70, 0x08, 0x07) /* Y */ \
+    G(0x00, 0x61, 0x51, 0x49, 0x45, 0x43) /* Z */ \
+    G(0x00, 0x00, 0x7F, 0x41, 0x41, 0x00) /* [ */ \
+    G(0x00, 0x55, 0x2A, 0x55, 0x2A, 0x55) /* 55 */ \
+    G(0x00, 0x00, 0x41, 0x41, 0x7F, 0x00) /* ] */ \
+    G(0x00, 0x04, 0x02, 0x01, 0x02, 0x04) /* ^ */ \
+    G(0x00, 0x40, 0x40, 0x40, 0x40, 0x40) /* _ */ \
+    G(0x00, 0x00, 0x01, 0x02, 0x04, 0x00) /* ' */ \
+    G(0x00, 0x20, 0x54, 0x54, 0x54, 0x78) /* a */ \
+    G(0x00, 0x7F, 0x48, 0x44, 0x44, 0x38) /* b */ \
+    G(0x00, 0x38, 0x44, 0x44, 0x44, 0x20) /* c */ \
+    G(0x00, 0x38, 0x44, 0x44, 0x48, 0x7F) /* d */ \
+    G(0x00, 0x38, 0x54, 0x54, 0x54, 0x18) /* e */ \
+    G(0x00, 0x08, 0x7E, 0x09, 0x01, 0x02) /* f */ \
+    G(0x00, 0x18, 0xA4, 0xA4, 0xA4, 0x7C) /* g */ \
+    G(0x00, 0x7F, 0x08, 0x04, 0x04, 0x78) /* h */ \
+    G(0x00, 0x00, 0x44, 0x7D, 0x40, 0x00) /* i */ \
+    G(0x00, 0x40, 0x80, 0x84, 0x7D, 0x00) /* j */ \
+    G(0x00, 0x7F, 0x10, 0x28, 0x44, 0x00) /* k */ \
+    G(0x00, 0x00, 0x41, 0x7F, 0x40, 0x00) /* l */ \
+    G(0x00, 0x7C, 0x04, 0x18, 0x04, 0x78) /* m */ \
+    G(0x00, 0x7C, 0x08, 0x04, 0x04, 0x78) /* n */ \
+    G(0x00, 0x38, 0x44, 0x44, 0x44, 0x38) /* o */ \
+    G(0x00, 0xFC, 0x24, 0x24, 0x24, 0x18) /* p */ \
+    G(0x00, 0x18, 0x24, 0x24, 0x18, 0xFC) /* q */ \
+    G(0x00, 0x7C, 0x08, 0x04, 0x04, 0x08) /* r */ \
+    G(0x00, 0x48, 0x54, 0x54, 0x54, 0x20) /* s */ \
+    G(0x00, 0x04, 0x3F, 0x44, 0x40, 0x20) /* t */ \
+    G(0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C) /* u */ \
+    G(0x00, 0x1C, 0x20, 0x40, 0x20, 0x1C) /* v */ \
+    G(0x00, 0x3C, 0x40, 0x30, 0x40, 0x3C) /* w */ \
+    G(0x00, 0x44, 0x28, 0x10, 0x28, 0x44) /* x */ \
+    G(0x00, 0x1C, 0xA0, 0xA0, 0xA0, 0x7C) /* y */ \
+    G(0x00, 0x44, 0x64, 0x54, 0x4C, 0x44) /* z */ \
+    G(0x00, 0x00, 0x08, 0x77, 0x00, 0x00) /* { */ \
+    G(0x00, 0x00, 0x00, 0x7F, 0x00, 0x00) /* | */ \
+    G(0x00, 0x00, 0x77, 0x08, 0x00, 0x00) /* } */ \
+    G(0x00, 0x10, 0x08, 0x10, 0x08, 0x00) /* ~ */ \
+    G(0x14, 0x14, 0x14, 0x14, 0x14, 0x14) /* horiz lines // DEL */
+
+/* monospaced 6x8 */
+#define SSD1306_GLYPH_1X(a, b, c, d, e, f)  { a, b, c, d, e, f },
+
+const uint8_t ssd1306_font6x8[][6] = {
+    SSD1306_FONT6X8_GLYPHS(SSD1306_GLYPH_1X)
+};
+
+const ssd1306_font_t ssd1306_font_6x8 = {
+    .glyphs = &ssd1306_font6x8[0][0],
+    .metrics = NULL,
+    .width = 6,
+    .pages = 1,
+    .first = ' ',
+    .count = sizeof(ssd1306_font6x8) / sizeof(ssd1306_font6x8[0]),
+    .spacing = 0,
+};
+
+/* proportional 6x8 - same glyphs, blank columns trimmed, space is 3 wide */
+#define SSD1306_FIRST_COL(a, b, c, d, e, f) ((a) ? 0 : (b) ? 1 : (c) ? 2 : (d) ? 3 : (e) ? 4 : 5)
+#define SSD1306_LAST_COL(a, b, c, d, e, f)  ((f) ? 5 : (e) ? 4 : (d) ? 3 : (c) ? 2 : (b) ? 1 : 0)
+#define SSD1306_GLYPH_METRICS(a, b, c, d, e, f) \
+    (((a) | (b) | (c) | (d) | (e) | (f)) == 0 ? 3 : \
+     (SSD1306_FIRST_COL(a, b, c, d, e, f) << 4) | \
+     (SSD1306_LAST_COL(a, b, c, d, e, f) - SSD1306_FIRST_COL(a, b, c, d, e, f) + 1)),
+
+static const uint8_t ssd1306_font6x8_metrics[] = {
+    SSD1306_FONT6X8_GLYPHS(SSD1306_GLYPH_METRICS)
+};
+
+const ssd1306_font_t ssd1306_font_6x8_prop = {
+    .glyphs = &ssd1306_font6x8[0][0],
+    .metrics = ssd1306_font6x8_metrics,
+    .width = 6,
+    .pages = 1,
+    .first = ' ',
+    .count = sizeof(ssd1306_font6x8) / sizeof(ssd1306_font6x8[0]),
+    .spacing = 1,
+};
+
+/* 2x scaled 12x16 - every bit becomes 2 rows, every column 2 columns of 2 pages */
+#define SSD1306_X2(b)   ((((b) >> 0) & 1) * 0x0003u | (((b) >> 1) & 1) * 0x000Cu | \
+                         (((b) >> 2) & 1) * 0x0030u | (((b) >> 3) & 1) * 0x00C0u | \
+                         (((b) >> 4) & 1) * 0x0300u | (((b) >> 5) & 1) * 0x0C00u | \
+                         (((b) >> 6) & 1) * 0x3000u | (((b) >> 7) & 1) * 0xC000u)
+#define SSD1306_COL_2X(b)   SSD1306_X2(b) & 0xFF, SSD1306_X2(b) >> 8
+#define SSD1306_GLYPH_2X(a, b, c, d, e, f) \
+    { SSD1306_COL_2X(a), SSD1306_COL_2X(a), SSD1306_COL_2X(b), SSD1306_COL_2X(b), \
+      SSD1306_COL_2X(c), SSD1306_COL_2X(c), SSD1306_COL_2X(d), SSD1306_COL_2X(d), \
+      SSD1306_COL_2X(e), SSD1306_COL_2X(e), SSD1306_COL_2X(f), SSD1306_COL_2X(f) },
+
+static const uint8_t ssd1306_font12x16[][12 * 2] = {
+    SSD1306_FONT6X8_GLYPHS(SSD1306_GLYPH_2X)
+};
+
+const ssd1306_font_t ssd1306_font_12x16 = {
+    .glyphs = &ssd1306_font12x16[0][0],
+    .metrics = NULL,
+    .width = 12,
+    .pages = 2,
+    .first = ' ',
+    .count = sizeof(ssd1306_font12x16) / sizeof(ssd1306_font12x16[0]),
+    .spacing = 0,
+};
+
+/* 3x scaled 18x24 - every bit becomes 3 rows, every column 3 columns of 3 pages */
+#define SSD1306_X3(b)   ((((b) >> 0) & 1) * 0x000007ul | (((b) >> 1) & 1) * 0x000038ul | \
+                         (((b) >> 2) & 1) * 0x0001C0ul | (((b) >> 3) & 1) * 0x000E00ul | \
+                         (((b) >> 4) & 1) * 0x007000ul | (((b) >> 5) & 1) * 0x038000ul | \
+                         (((b) >> 6) & 1) * 0x1C0000ul | (((b) >> 7) & 1) * 0xE00000ul)
+#define SSD1306_COL_3X(b)   SSD1306_X3(b) & 0xFF, (SSD1306_X3(b) >> 8) & 0xFF, SSD1306_X3(b) >> 16
+#define SSD1306_COLS_3X(b)  SSD1306_COL_3X(b), SSD1306_COL_3X(b), SSD1306_COL_3X(b)
+#define SSD1306_GLYPH_3X(a, b, c, d, e, f) \
+    { SSD1306_COLS_3X(a), SSD1306_COLS_3X(b), SSD1306_COLS_3X(c), \
+      SSD1306_COLS_3X(d), SSD1306_COLS_3X(e), SSD1306_COLS_3X(f) },
+
+static const uint8_t ssd1306_font18x24[][18 * 3] = {
+    SSD1306_FONT6X8_GLYPHS(SSD1306_GLYPH_3X)
+};
+
+const ssd1306_font_t ssd1306_font_18x24 = {
+    .glyphs = &ssd1306_font18x24[0][0],
+    .metrics = NULL,
+    .width = 18,
+    .pages = 3,
+    .first = ' ',
+    .count = sizeof(ssd1306_font18x24) / sizeof(ssd1306_font18x24[0]),
+    .spacing = 0,
+};
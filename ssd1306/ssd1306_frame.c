@@ -0,0 +1,73 @@
+
+#include <string.h>
+#include "ssd1306_frame.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+/* timer interrupt, only opens the slot, the refresh starts in thread context */
+static bool ssd1306_frame_tick(repeating_timer_t* timer){
+    ssd1306_frame_t* sched = timer->user_data;
+
+    sched->slot_us = time_us_32();
+    __dmb();
+    sched->slot++;
+    __sev();
+
+    return true;
+}
+
+bool ssd1306_frame_start(ssd1306_frame_t* sched, ssd1306_t* disp, uint32_t fps){
+    /* 0 has no period, anything near 1 MHz rounds to a zero period that floods the timer interrupt */
+    if(fps == 0 || fps > SSD1306_FRAME_FPS_MAX)
+        return false;
+
+    memset(sched, 0, sizeof(*sched));
+    sched->disp = disp;
+
+    /* negative delay: the period runs from one callback start to the next, no drift */
+    return add_repeating_timer_us(-(int64_t)(1000000 / fps), ssd1306_frame_tick, sched, &sched->timer);
+}
+
+void ssd1306_frame_stop(ssd1306_frame_t* sched){
+    cancel_repeating_timer(&sched->timer);
+}
+
+void ssd1306_frame_request(ssd1306_frame_t* sched){
+    sched->pending = true;
+    sched->stats.requests++;
+}
+
+bool ssd1306_frame_wait(ssd1306_frame_t* sched){
+    uint32_t slot, late;
+
+    /* the timer interrupt wakes the core */
+    while((slot = sched->slot) == sched->seen)
+        __wfe();
+
+    if(slot - sched->seen > 1)
+        sched->stats.missed += slot - sched->seen - 1;
+    sched->seen = slot;
+
+    if(!sched->pending)
+        return false;
+
+    if(ssd1306_busy(sched->disp)){
+        sched->stats.skipped++;
+        return false;
+    }
+
+    __dmb();
+    late = time_us_32() - sched->slot_us;
+    if(late > sched->stats.late_max_us)
+        sched->stats.late_max_us = late;
+
+    sched->pending = false;
+    sched->stats.frames++;
+    ssd1306_refresh_async(sched->disp, NULL);
+
+    return true;
+}
+
+void ssd1306_frame_stats(ssd1306_frame_t* sched, ssd1306_frame_stats_t* stats){
+    *stats = sched->stats;
+}
@@ -0,0 +1,52 @@
+#ifndef SSD1306_FRAME_H
+#define SSD1306_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/time.h"
+#include "ssd1306.h"
+
+/*
+ * RP2040 frame pacing. A repeating hardware timer opens a frame slot at the
+ * target frame rate. The application draws into vram and calls
+ * ssd1306_frame_request once the frame is consistent, any number of requests
+ * between two slots go out as one refresh. ssd1306_frame_wait sleeps until
+ * the next slot and starts the refresh there. A slot that finds the previous
+ * transfer still on the bus is skipped, the request then moves to the next
+ * slot.
+ */
+
+/* highest target rate, a 1 ms period is far beyond what a panel shows */
+#define SSD1306_FRAME_FPS_MAX   1000
+
+typedef struct {
+    uint32_t requests;              /* calls to ssd1306_frame_request */
+    uint32_t frames;                /* refreshes started, requests - frames were coalesced */
+    uint32_t skipped;               /* slots with a request while the bus was busy */
+    uint32_t missed;                /* slots that passed before ssd1306_frame_wait got to them */
+    uint32_t late_max_us;           /* worst delay from a slot to its refresh start */
+} ssd1306_frame_stats_t;
+
+typedef struct {
+    ssd1306_t* disp;
+    repeating_timer_t timer;
+    volatile uint32_t slot;         /* slots opened by the timer */
+    volatile uint32_t slot_us;      /* when the last one opened, low timer word */
+    uint32_t seen;                  /* last slot handled by ssd1306_frame_wait */
+    bool pending;
+    ssd1306_frame_stats_t stats;
+} ssd1306_frame_t;
+
+/* starts the slot timer for an initialised display, false for 0 or more than SSD1306_FRAME_FPS_MAX fps or if no timer is free */
+bool ssd1306_frame_start(ssd1306_frame_t* sched, ssd1306_t* disp, uint32_t fps);
+void ssd1306_frame_stop(ssd1306_frame_t* sched);
+
+/* vram holds a frame to show, sent in the next free slot */
+void ssd1306_frame_request(ssd1306_frame_t* sched);
+
+/* sleeps until the next slot, returns true if a refresh was started in it */
+bool ssd1306_frame_wait(ssd1306_frame_t* sched);
+
+void ssd1306_frame_stats(ssd1306_frame_t* sched, ssd1306_frame_stats_t* stats);
+
+#endif
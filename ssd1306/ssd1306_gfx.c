@@ -0,0 +1,207 @@
+
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306.h"
+
+/* 32-bit access to vram, allowed to alias the byte array */
+typedef uint32_t __attribute__((__may_alias__)) ssd1306_word_t;
+
+static inline void ssd1306_apply(uint8_t* byte, uint8_t mask, uint8_t color){
+    switch(color){
+        case SSD1306_BLACK: *byte &= ~mask; break;
+        case SSD1306_WHITE: *byte |= mask; break;
+        default:            *byte ^= mask; break;
+    }
+}
+
+/*
+ * Applies one page mask to count consecutive bytes of a page row. Whole
+ * bytes are plain memsets, partial masks go 32 bits (4 columns) at a time
+ * with the unaligned head and tail done bytewise.
+ */
+static void ssd1306_span(uint8_t* row, int16_t count, uint8_t mask, uint8_t color){
+    uint32_t mask32 = mask * 0x01010101u;
+    ssd1306_word_t* word;
+
+    if(mask == 0xFF && color != SSD1306_INVERT){
+        memset(row, color == SSD1306_WHITE ? 0xFF : 0x00, count);
+        return;
+    }
+
+    for(; count && ((uintptr_t)row & 3); count--)
+        ssd1306_apply(row++, mask, color);
+
+    word = (ssd1306_word_t*)row;
+    switch(color){
+        case SSD1306_BLACK: for(; count >= 4; count -= 4) *word++ &= ~mask32; break;
+        case SSD1306_WHITE: for(; count >= 4; count -= 4) *word++ |= mask32; break;
+        default:            for(; count >= 4; count -= 4) *word++ ^= mask32; break;
+    }
+
+    for(row = (uint8_t*)word; count; count--)
+        ssd1306_apply(row++, mask, color);
+}
+
+/* plots with clipping, without dirty marking. Strip displays have no frame to draw into */
+static inline void ssd1306_plot(ssd1306_t* disp, int16_t x, int16_t y, uint8_t color){
+    if(!disp->strip && x >= 0 && x < disp->width && y >= 0 && y < disp->height)
+        ssd1306_apply(&disp->vram[(y >> 3) * disp->width + x], 1 << (y & 0x07), color);
+}
+
+/* marks the visible part of a bounding box dirty */
+static void ssd1306_mark_box(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t x1, int16_t y1){
+    if(x0 < 0) x0 = 0;
+    if(y0 < 0) y0 = 0;
+    if(x1 > disp->width - 1) x1 = disp->width - 1;
+    if(y1 > disp->height - 1) y1 = disp->height - 1;
+
+    if(x0 <= x1 && y0 <= y1)
+        ssd1306_mark_dirty(disp, x0, x1, y0 >> 3, y1 >> 3);
+}
+
+void ssd1306_draw_pixel(ssd1306_t* disp, uint16_t x, uint16_t y, uint8_t value){
+    if(disp->strip || x >= disp->width || y >= disp->height)
+        return;
+
+    ssd1306_apply(&disp->vram[(y >> 3) * disp->width + x], 1 << (y & 0x07), value);
+    ssd1306_mark_dirty(disp, x, x, y >> 3, y >> 3);
+}
+
+/* clipped rectangle fill, inlined per geometry by SSD1306_SPECIALISE */
+static inline __attribute__((always_inline))
+void ssd1306_fill(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color, const int W, const int P){
+    if(disp->strip)
+        return;
+
+    /* clip */
+    if(x < 0){ w += x; x = 0; }
+    if(y < 0){ h += y; y = 0; }
+    if(x + w > W) w = W - x;
+    if(y + h > P * 8) h = P * 8 - y;
+    if(w <= 0 || h <= 0)
+        return;
+
+    int16_t y_end = y + h - 1;
+    int page_start = y >> 3;
+    int page_end = y_end >> 3;
+
+    for(int page = page_start; page <= page_end; page++){
+        uint8_t mask = 0xFF;
+
+        /* partial masks only on the first and last page */
+        if(page == page_start) mask &= 0xFF << (y & 0x07);
+        if(page == page_end)   mask &= 0xFF >> (7 - (y_end & 0x07));
+
+        ssd1306_span(&disp->vram[page * W + x], w, mask, color);
+    }
+
+    ssd1306_mark_dirty(disp, x, x + w - 1, page_start, page_end);
+}
+
+void ssd1306_fill_rect(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color){
+    SSD1306_SPECIALISE(disp, ssd1306_fill(disp, x, y, w, h, color, W, P));
+}
+
+void ssd1306_draw_hline(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, uint8_t color){
+    ssd1306_fill_rect(disp, x, y, w, 1, color);
+}
+
+void ssd1306_draw_vline(ssd1306_t* disp, int16_t x, int16_t y, int16_t h, uint8_t color){
+    ssd1306_fill_rect(disp, x, y, 1, h, color);
+}
+
+/* outline, corners are drawn once so SSD1306_INVERT works */
+void ssd1306_draw_rect(ssd1306_t* disp, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color){
+    if(w <= 0 || h <= 0)
+        return;
+
+    ssd1306_draw_hline(disp, x, y, w, color);
+    if(h > 1)
+        ssd1306_draw_hline(disp, x, y + h - 1, w, color);
+    if(h > 2){
+        ssd1306_draw_vline(disp, x, y + 1, h - 2, color);
+        if(w > 1)
+            ssd1306_draw_vline(disp, x + w - 1, y + 1, h - 2, color);
+    }
+}
+
+/* Bresenham, straight lines go through the span fills */
+void ssd1306_draw_line(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color){
+    int16_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int16_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+
+    if(y0 == y1){
+        ssd1306_draw_hline(disp, x0 < x1 ? x0 : x1, y0, dx + 1, color);
+        return;
+    }
+    if(x0 == x1){
+        ssd1306_draw_vline(disp, x0, y0 < y1 ? y0 : y1, -dy + 1, color);
+        return;
+    }
+
+    ssd1306_mark_box(disp, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, x0 < x1 ? x1 : x0, y0 < y1 ? y1 : y0);
+
+    while(1){
+        ssd1306_plot(disp, x0, y0, color);
+        if(x0 == x1 && y0 == y1)
+            break;
+
+        int16_t e2 = 2 * err;
+        if(e2 >= dy){ err += dy; x0 += sx; }
+        if(e2 <= dx){ err += dx; y0 += sy; }
+    }
+}
+
+/* plots (+-a, +-b) around the center, each distinct point once */
+static void ssd1306_plot4(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t a, int16_t b, uint8_t color){
+    ssd1306_plot(disp, x0 + a, y0 + b, color);
+    if(a)
+        ssd1306_plot(disp, x0 - a, y0 + b, color);
+    if(b){
+        ssd1306_plot(disp, x0 + a, y0 - b, color);
+        if(a)
+            ssd1306_plot(disp, x0 - a, y0 - b, color);
+    }
+}
+
+/* midpoint circle */
+void ssd1306_draw_circle(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t r, uint8_t color){
+    int16_t x = r, y = 0, err = 1 - r;
+
+    if(r < 0)
+        return;
+
+    ssd1306_mark_box(disp, x0 - r, y0 - r, x0 + r, y0 + r);
+
+    while(x >= y){
+        ssd1306_plot4(disp, x0, y0, x, y, color);
+        if(x != y)
+            ssd1306_plot4(disp, x0, y0, y, x, color);
+
+        y++;
+        if(err < 0)
+            err += 2 * y + 1;
+        else{
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+/* one vertical span per column, so every pixel is touched once */
+void ssd1306_fill_circle(ssd1306_t* disp, int16_t x0, int16_t y0, int16_t r, uint8_t color){
+    int16_t dy = r;
+
+    if(r < 0)
+        return;
+
+    for(int16_t dx = 0; dx <= r; dx++){
+        while(dx * dx + dy * dy > r * r + r)
+            dy--;
+
+        ssd1306_draw_vline(disp, x0 + dx, y0 - dy, 2 * dy + 1, color);
+        if(dx)
+            ssd1306_draw_vline(disp, x0 - dx, y0 - dy, 2 * dy + 1, color);
+    }
+}
@@ -0,0 +1,76 @@
+
+#include <string.h>
+#include "ssd1306.h"
+
+/* plane shown in every phase of the cycle, bit 1 weighs twice bit 0 */
+static const uint8_t ssd1306_gray_frames[] = { 1, 1, 0 };
+static const uint8_t ssd1306_gray_contrast[] = { 1, 0 };
+
+void ssd1306_gray_init(ssd1306_gray_t* gray, ssd1306_t* disp, uint8_t* planes, uint8_t mode){
+    size_t size = disp->width * disp->pages;
+
+    gray->disp = disp;
+    gray->mode = mode;
+    gray->phase = 0;
+    gray->contrast = 0xFF;
+
+    /* plane displays only take drawing, their dirty ranges are never used */
+    for(int bit = 0; bit < 2; bit++){
+        gray->plane[bit] = (ssd1306_t){
+            .width = disp->width, .height = disp->height, .pages = disp->pages,
+            .vram = &planes[bit * size],
+            .dirty_start = gray->plane_dirty[bit][0], .dirty_stop = gray->plane_dirty[bit][1],
+            .batch_run = SSD1306_BATCH_NONE,
+        };
+        memset(gray->plane_dirty[bit][0], disp->width, disp->pages);
+        memset(gray->plane_dirty[bit][1], 0, disp->pages);
+    }
+    memset(planes, 0x00, 2 * size);
+}
+
+/*
+ * Shows the next phase: copies its plane into vram, marking only the changed
+ * columns of every page dirty, and starts an asynchronous refresh. Returns
+ * false without advancing while the previous phase is still being queued,
+ * or for strip displays, which have no frame to copy the plane into.
+ */
+bool ssd1306_gray_step(ssd1306_gray_t* gray){
+    ssd1306_t* disp = gray->disp;
+    bool contrast = gray->mode == SSD1306_GRAY_CONTRAST;
+    uint8_t phase = (gray->phase + 1) % (contrast ? sizeof(ssd1306_gray_contrast) : sizeof(ssd1306_gray_frames));
+    uint8_t bit = contrast ? ssd1306_gray_contrast[phase] : ssd1306_gray_frames[phase];
+    const uint8_t* plane = gray->plane[bit].vram;
+
+    if(disp->strip || ssd1306_busy(disp))
+        return false;
+
+    for(int page = 0; page < disp->pages; page++){
+        const uint8_t* from = &plane[page * disp->width];
+        uint8_t* to = &disp->vram[page * disp->width];
+        int first = 0, last = disp->width - 1;
+
+        while(first <= last && from[first] == to[first])
+            first++;
+        while(last >= first && from[last] == to[last])
+            last--;
+        if(first > last)
+            continue;
+
+        memcpy(&to[first], &from[first], last - first + 1);
+        ssd1306_mark_dirty(disp, first, last, page, page);
+    }
+
+    /*
+     * contrast is roughly linear in brightness, half of it stands in for bit 0.
+     * It follows the plane in the same stream, so it switches as the data lands
+     */
+    if(contrast){
+        uint8_t cmd[] = { SSD1306_SETCONTRAST, bit ? gray->contrast : gray->contrast / 2 };
+        ssd1306_refresh_async_cmd(disp, cmd, sizeof(cmd), NULL);
+    }
+    else
+        ssd1306_refresh_async(disp, NULL);
+    gray->phase = phase;
+
+    return true;
+}
@@ -0,0 +1,194 @@
+
+#include <string.h>
+#include "ssd1306.h"
+
+/*
+ * Display lists. Every op keeps the arguments of its draw call:
+ *
+ *   PIXEL          x0, y0
+ *   LINE           x0, y0 to x1, y1
+ *   RECT, FILL_RECT x0, y0, width x1, height y1
+ *   CIRCLE, FILL_CIRCLE center x0, y0, radius x1
+ *   STRING         x0, y0, data, font
+ *   BITMAP         x0, y0, data
+ *
+ * Rendering replays them on a one page display whose row 0 is the top of
+ * the current strip, so the regular drawing code does the clipping.
+ */
+
+void ssd1306_list_init(ssd1306_list_t* list, ssd1306_op_t* ops, uint16_t capacity){
+    list->ops = ops;
+    list->capacity = capacity;
+    list->count = 0;
+}
+
+void ssd1306_list_clear(ssd1306_list_t* list){
+    list->count = 0;
+}
+
+static ssd1306_op_t* ssd1306_list_add(ssd1306_list_t* list, uint8_t op, uint8_t color, int16_t top, int16_t bottom){
+    ssd1306_op_t* entry;
+
+    if(list->count >= list->capacity)
+        return NULL;
+
+    entry = &list->ops[list->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->op = op;
+    entry->color = color;
+    entry->top = top;
+    entry->bottom = bottom;
+    return entry;
+}
+
+bool ssd1306_list_pixel(ssd1306_list_t* list, int16_t x, int16_t y, uint8_t color){
+    ssd1306_op_t* op = ssd1306_list_add(list, SSD1306_OP_PIXEL, color, y, y);
+
+    if(!op)
+        return false;
+    op->x0 = x;
+    op->y0 = y;
+    return true;
+}
+
+bool ssd1306_list_line(ssd1306_list_t* list, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color){
+    ssd1306_op_t* op = ssd1306_list_add(list, SSD1306_OP_LINE, color, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0);
+
+    if(!op)
+        return false;
+    op->x0 = x0;
+    op->y0 = y0;
+    op->x1 = x1;
+    op->y1 = y1;
+    return true;
+}
+
+static bool ssd1306_list_box(ssd1306_list_t* list, uint8_t type, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color){
+    ssd1306_op_t* op = ssd1306_list_add(list, type, color, y, y + h - 1);
+
+    if(!op)
+        return false;
+    op->x0 = x;
+    op->y0 = y;
+    op->x1 = w;
+    op->y1 = h;
+    return true;
+}
+
+bool ssd1306_list_rect(ssd1306_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color){
+    return ssd1306_list_box(list, SSD1306_OP_RECT, x, y, w, h, color);
+}
+
+bool ssd1306_list_fill_rect(ssd1306_list_t* list, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color){
+    return ssd1306_list_box(list, SSD1306_OP_FILL_RECT, x, y, w, h, color);
+}
+
+static bool ssd1306_list_round(ssd1306_list_t* list, uint8_t type, int16_t x0, int16_t y0, int16_t r, uint8_t color){
+    ssd1306_op_t* op = ssd1306_list_add(list, type, color, y0 - r, y0 + r);
+
+    if(!op)
+        return false;
+    op->x0 = x0;
+    op->y0 = y0;
+    op->x1 = r;
+    return true;
+}
+
+bool ssd1306_list_circle(ssd1306_list_t* list, int16_t x0, int16_t y0, int16_t r, uint8_t color){
+    return ssd1306_list_round(list, SSD1306_OP_CIRCLE, x0, y0, r, color);
+}
+
+bool ssd1306_list_fill_circle(ssd1306_list_t* list, int16_t x0, int16_t y0, int16_t r, uint8_t color){
+    return ssd1306_list_round(list, SSD1306_OP_FILL_CIRCLE, x0, y0, r, color);
+}
+
+bool ssd1306_list_string(ssd1306_list_t* list, int16_t x, int16_t y, const char* str, const ssd1306_font_t* font, uint8_t color){
+    ssd1306_op_t* op = ssd1306_list_add(list, SSD1306_OP_STRING, color, y, y + font->pages * 8 - 1);
+
+    if(!op)
+        return false;
+    op->x0 = x;
+    op->y0 = y;
+    op->data = str;
+    op->font = font;
+    return true;
+}
+
+bool ssd1306_list_bitmap(ssd1306_list_t* list, int16_t x, int16_t y, const ssd1306_bitmap_t* bitmap){
+    ssd1306_op_t* op = ssd1306_list_add(list, SSD1306_OP_BITMAP, 0, y, y + bitmap->pages * 8 - 1);
+
+    if(!op)
+        return false;
+    op->x0 = x;
+    op->y0 = y;
+    op->data = bitmap;
+    return true;
+}
+
+/* replays one op on the strip display, rows shifted up by top */
+static void ssd1306_list_draw(ssd1306_t* strip, const ssd1306_op_t* op, int16_t top){
+    int16_t y0 = op->y0 - top;
+
+    switch(op->op){
+        case SSD1306_OP_PIXEL:
+            if(op->x0 >= 0 && y0 >= 0)
+                ssd1306_draw_pixel(strip, op->x0, y0, op->color);
+            break;
+        case SSD1306_OP_LINE:
+            ssd1306_draw_line(strip, op->x0, y0, op->x1, op->y1 - top, op->color);
+            break;
+        case SSD1306_OP_RECT:
+            ssd1306_draw_rect(strip, op->x0, y0, op->x1, op->y1, op->color);
+            break;
+        case SSD1306_OP_FILL_RECT:
+            ssd1306_fill_rect(strip, op->x0, y0, op->x1, op->y1, op->color);
+            break;
+        case SSD1306_OP_CIRCLE:
+            ssd1306_draw_circle(strip, op->x0, y0, op->x1, op->color);
+            break;
+        case SSD1306_OP_FILL_CIRCLE:
+            ssd1306_fill_circle(strip, op->x0, y0, op->x1, op->color);
+            break;
+        case SSD1306_OP_STRING:
+            ssd1306_draw_string(strip, op->x0, y0, (const char*)op->data, op->font, op->color);
+            break;
+        case SSD1306_OP_BITMAP:
+            ssd1306_draw_bitmap(strip, op->x0, y0, (const ssd1306_bitmap_t*)op->data);
+            break;
+    }
+}
+
+/*
+ * Rasterises the list one page at a time into the one page vram of disp
+ * (see SSD1306_DEFINE_STRIP, a full display renders into its own vram) and
+ * sends every page through the asynchronous path. A page is copied into the
+ * transfer buffer once the previous one is sent, so rendering the next page
+ * overlaps with the bus. Returns with the last page in flight.
+ */
+void ssd1306_list_render(ssd1306_t* disp, const ssd1306_list_t* list){
+    uint8_t dirty_start, dirty_stop;
+    ssd1306_t strip = {
+        .transport = disp->transport, .address = disp->address,
+        .width = disp->width, .height = 8, .pages = 1,
+        .vram = disp->vram,
+        .dirty_start = &dirty_start, .dirty_stop = &dirty_stop,
+        .batch_run = SSD1306_BATCH_NONE,
+    };
+
+    for(int page = 0; page < disp->pages; page++){
+        int16_t top = page * 8;
+
+        /* a full display keeps the frame in its vram */
+        if(!disp->strip)
+            strip.vram = &disp->vram[page * disp->width];
+
+        memset(strip.vram, 0x00, strip.width);
+        for(uint16_t i = 0; i < list->count; i++){
+            const ssd1306_op_t* op = &list->ops[i];
+            if(op->bottom >= top && op->top <= top + 7)
+                ssd1306_list_draw(&strip, op, top);
+        }
+
+        ssd1306_send_page_async(disp, page, strip.vram);
+    }
+}
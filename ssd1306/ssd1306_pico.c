@@ -0,0 +1,202 @@
+
+#include "ssd1306.h"
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+/* RP2040 transport - blocking writes straight to the I2C controller, streams through DMA */
+
+/* one per I2C controller, the context of its transport */
+typedef struct {
+    i2c_inst_t* i2c;
+    int dma_channel;
+    volatile bool busy;             /* stream still being queued by DMA */
+    ssd1306_done_t done;
+    void* done_arg;
+} ssd1306_pico_bus_t;
+
+static ssd1306_pico_bus_t ssd1306_pico_bus[2] = {
+    { .i2c = i2c0, .dma_channel = -1 },
+    { .i2c = i2c1, .dma_channel = -1 },
+};
+
+/* transactions give up after this, a missing display or a stuck bus must not hang the caller */
+#define SSD1306_PICO_TIMEOUT_US(bytes)  (1000 + (bytes) * 100)    /* 100 kHz is 90 us per byte */
+
+/*
+ * Flushes the TX FIFO and lets the controller issue a STOP. ABORT clears
+ * itself once that is done, then the abort and the STOP are acknowledged so
+ * the next transfer starts on an idle controller.
+ */
+static void ssd1306_pico_abort(i2c_hw_t* hw){
+    uint64_t deadline = time_us_64() + SSD1306_PICO_TIMEOUT_US(0);
+
+    hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+    while((hw->enable & I2C_IC_ENABLE_ABORT_BITS) && time_us_64() < deadline)
+        tight_loop_contents();
+
+    (void)hw->clr_tx_abrt;
+    (void)hw->clr_stop_det;
+}
+
+/*
+ * Gathered blocking write. i2c_write_blocking only takes one buffer, so the
+ * segments are fed to IC_DATA_CMD directly, keeping the TX FIFO full instead
+ * of waiting for it to drain after every byte.
+ */
+static int ssd1306_pico_write(void* context, uint8_t address, const ssd1306_segment_t* segments, size_t count){
+    i2c_inst_t* i2c = ((ssd1306_pico_bus_t*)context)->i2c;
+    i2c_hw_t* hw = i2c_get_hw(i2c);
+    int lenght = 0;
+    uint64_t deadline;
+
+    for(size_t i = 0; i < count; i++)
+        lenght += segments[i].lenght;
+    deadline = time_us_64() + SSD1306_PICO_TIMEOUT_US(lenght + 1);
+
+    /* target address can only be changed while the controller is disabled */
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+    (void)hw->clr_stop_det;     /* left over from earlier streams */
+
+    for(size_t i = 0; i < count; i++){
+        for(size_t j = 0; j < segments[i].lenght; j++){
+            bool last = i == count - 1 && j == segments[i].lenght - 1;
+
+            while(!i2c_get_write_available(i2c) && time_us_64() < deadline)
+                tight_loop_contents();
+            if(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS || time_us_64() >= deadline)
+                break;
+
+            hw->data_cmd = segments[i].data[j] | (last ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+        }
+    }
+
+    /* STOP is also generated when the transfer aborts */
+    while(!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS)){
+        if(time_us_64() >= deadline){
+            ssd1306_pico_abort(hw);
+            return PICO_ERROR_TIMEOUT;
+        }
+        tight_loop_contents();
+    }
+    (void)hw->clr_stop_det;
+
+    if(hw->tx_abrt_source){
+        (void)hw->clr_tx_abrt;
+        return PICO_ERROR_GENERIC;
+    }
+
+    return lenght;
+}
+
+static void ssd1306_pico_dma_irq_handler(){
+    for(int i = 0; i < 2; i++){
+        ssd1306_pico_bus_t* bus = &ssd1306_pico_bus[i];
+
+        /* shared handler, only our channels */
+        if(bus->dma_channel < 0 || !dma_channel_get_irq0_status(bus->dma_channel))
+            continue;
+
+        dma_channel_acknowledge_irq0(bus->dma_channel);
+        bus->busy = false;
+
+        if(bus->done)
+            bus->done(bus->done_arg);
+    }
+}
+
+static void ssd1306_pico_dma_init(ssd1306_pico_bus_t* bus){
+    static bool irq_installed;
+
+    bus->dma_channel = dma_claim_unused_channel(true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(bus->dma_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_hw_index(bus->i2c) ? DREQ_I2C1_TX : DREQ_I2C0_TX);
+    dma_channel_configure(bus->dma_channel, &cfg, &i2c_get_hw(bus->i2c)->data_cmd, NULL, 0, false);
+
+    dma_channel_set_irq0_enabled(bus->dma_channel, true);
+    if(!irq_installed){
+        irq_add_shared_handler(DMA_IRQ_0, ssd1306_pico_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        irq_installed = true;
+    }
+}
+
+/*
+ * IO registers ignore the access width, so a byte wide DMA write to
+ * IC_DATA_CMD would be replicated into the CMD/STOP/RESTART bits. The stream
+ * is already made of 16-bit data command words (SSD1306_STREAM_STOP is the
+ * STOP bit) and goes to the TX FIFO as is. The controller starts a new
+ * transaction by itself when data follows a STOP.
+ */
+static void ssd1306_pico_write_stream(void* context, uint8_t address, const uint16_t* stream, size_t count,
+                                      ssd1306_done_t done, void* arg){
+    ssd1306_pico_bus_t* bus = (ssd1306_pico_bus_t*)context;
+    i2c_hw_t* hw = i2c_get_hw(bus->i2c);
+
+    if(bus->dma_channel < 0)
+        ssd1306_pico_dma_init(bus);
+
+    /* target address can only be changed while the controller is disabled */
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+
+    bus->done = done;
+    bus->done_arg = arg;
+    bus->busy = true;
+    dma_channel_transfer_from_buffer_now(bus->dma_channel, stream, count);
+}
+
+static bool ssd1306_pico_busy(void* context){
+    return ((ssd1306_pico_bus_t*)context)->busy;
+}
+
+static int ssd1306_pico_wait(void* context){
+    ssd1306_pico_bus_t* bus = (ssd1306_pico_bus_t*)context;
+    i2c_hw_t* hw = i2c_get_hw(bus->i2c);
+
+    if(bus->dma_channel >= 0){
+        /* another display on this bus may still be streaming */
+        while(bus->busy)
+            tight_loop_contents();
+
+        /* DMA only fills the TX FIFO, let the controller drain it */
+        while(!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+            tight_loop_contents();
+    }
+
+    /* a NACK aborts the transfer and holds the FIFO flushed until cleared, streamed or not */
+    if(hw->tx_abrt_source){
+        (void)hw->clr_tx_abrt;
+        return PICO_ERROR_GENERIC;
+    }
+
+    return 0;
+}
+
+uint64_t ssd1306_time_us(void){
+    return time_us_64();
+}
+
+const ssd1306_transport_t ssd1306_transport_default = {
+    .context = &ssd1306_pico_bus[0],
+    .write = ssd1306_pico_write,
+    .write_stream = ssd1306_pico_write_stream,
+    .busy = ssd1306_pico_busy,
+    .wait = ssd1306_pico_wait,
+};
+
+const ssd1306_transport_t ssd1306_transport_i2c1 = {
+    .context = &ssd1306_pico_bus[1],
+    .write = ssd1306_pico_write,
+    .write_stream = ssd1306_pico_write_stream,
+    .busy = ssd1306_pico_busy,
+    .wait = ssd1306_pico_wait,
+};
@@ -0,0 +1,60 @@
+
+#include "ssd1306.h"
+
+/*
+ * Hardware scrolling. Horizontal scrolling rotates the GDDRAM contents of
+ * the scrolled pages, so they no longer match vram once it is stopped and
+ * are sent again in full. Vertical scrolling only moves the display start
+ * row and leaves GDDRAM untouched.
+ */
+
+void ssd1306_scroll_setup(ssd1306_t* disp, uint8_t direction, uint8_t page_start, uint8_t page_end,
+                          uint8_t interval, uint8_t vertical){
+    bool diagonal = direction == SSD1306_SCROLL_SETUP_HV_RIGHT || direction == SSD1306_SCROLL_SETUP_HV_LEFT;
+    uint8_t cmd[] = {
+        direction,
+        0x00,                           /* dummy */
+        page_start & 0x07,
+        interval & 0x07,
+        page_end & 0x07,
+        diagonal ? vertical & 0x3F : 0x00,
+        0xFF,                           /* dummy, horizontal only */
+    };
+
+    /* the setup commands are only valid while scrolling is stopped */
+    ssd1306_scroll_stop(disp);
+
+    ssd1306_send_cmdlist(disp, cmd, diagonal ? sizeof(cmd) - 1 : sizeof(cmd));
+    disp->scroll_page_start = page_start;
+    disp->scroll_page_end = page_end;
+}
+
+/* rows fixed at the top and rows scrolled below them, for the diagonal modes */
+void ssd1306_scroll_area(ssd1306_t* disp, uint8_t fixed_rows, uint8_t rows){
+    uint8_t cmd[] = { SSD1306_SCROLL_SETUP_V, fixed_rows & 0x3F, rows & 0x7F };
+
+    ssd1306_scroll_stop(disp);
+    ssd1306_send_cmdlist(disp, cmd, sizeof(cmd));
+}
+
+/* brings GDDRAM up to date, then hands the scrolled pages to the controller */
+void ssd1306_scroll_start(ssd1306_t* disp){
+    static const uint8_t cmd[] = { SSD1306_SCROLL_ACTIVATE };
+
+    ssd1306_refresh(disp);
+    ssd1306_send_cmdlist(disp, cmd, sizeof(cmd));
+    disp->scrolling = true;
+}
+
+void ssd1306_scroll_stop(ssd1306_t* disp){
+    static const uint8_t cmd[] = { SSD1306_SCROLL_DEACTIVATE };
+
+    if(!disp->scrolling)
+        return;
+
+    ssd1306_send_cmdlist(disp, cmd, sizeof(cmd));
+    disp->scrolling = false;
+
+    /* resync the rotated pages on the next refresh */
+    ssd1306_mark_dirty(disp, 0, disp->width - 1, disp->scroll_page_start, disp->scroll_page_end);
+}
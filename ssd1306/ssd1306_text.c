@@ -0,0 +1,150 @@
+
+#include <string.h>
+#include "ssd1306.h"
+
+/*
+ * Glyphs drawn at a y that is not a multiple of 8 straddle one page more than
+ * they are high. The cache keeps such glyphs already shifted, pages + 1 bytes
+ * per column, so drawing them is one OR (AND, XOR) per byte - two per column
+ * for the 8 pixel fonts. Direct mapped on font, glyph and shift.
+ */
+typedef struct {
+    const ssd1306_font_t* font;
+    uint8_t glyph;
+    uint8_t shift;
+    uint8_t columns[SSD1306_GLYPH_CACHE_BYTES];
+} ssd1306_glyph_cache_t;
+
+static ssd1306_glyph_cache_t ssd1306_glyph_cache[SSD1306_GLYPH_CACHE_SIZE];
+
+/* glyph index of a character, unknown characters draw as the first glyph (space) */
+static uint8_t ssd1306_glyph_index(const ssd1306_font_t* font, char c){
+    uint8_t index = (uint8_t)c - font->first;
+    return index < font->count ? index : 0;
+}
+
+/* first drawn column and drawn width of a glyph */
+static void ssd1306_glyph_metrics(const ssd1306_font_t* font, uint8_t index, uint8_t* first, uint8_t* width){
+    if(font->metrics){
+        *first = font->metrics[index] >> 4;
+        *width = font->metrics[index] & 0x0F;
+    }
+    else{
+        *first = 0;
+        *width = font->width;
+    }
+}
+
+/* shifts width columns of a glyph down by shift rows into pages + 1 bytes per column */
+static void ssd1306_glyph_shift(const uint8_t* glyph, uint8_t pages, uint8_t width, uint8_t shift, uint8_t* out){
+    for(int col = 0; col < width; col++){
+        uint8_t carry = 0;
+
+        for(int page = 0; page < pages; page++){
+            uint8_t b = *glyph++;
+            *out++ = (b << shift) | carry;
+            carry = b >> (8 - shift);
+        }
+        *out++ = carry;
+    }
+}
+
+static const uint8_t* ssd1306_glyph_cached(const ssd1306_font_t* font, uint8_t index, const uint8_t* glyph,
+                                           uint8_t width, uint8_t shift){
+    ssd1306_glyph_cache_t* entry =
+        &ssd1306_glyph_cache[(index * 7 + shift + ((uintptr_t)font >> 2)) % SSD1306_GLYPH_CACHE_SIZE];
+
+    if(entry->font != font || entry->glyph != index || entry->shift != shift){
+        ssd1306_glyph_shift(glyph, font->pages, width, shift, entry->columns);
+        entry->font = font;
+        entry->glyph = index;
+        entry->shift = shift;
+    }
+
+    return entry->columns;
+}
+
+/* applies column bytes (bytes per column) to vram with clipping, inlined per geometry */
+static inline __attribute__((always_inline))
+void ssd1306_blit_to(uint8_t* vram, int16_t x, int16_t page, const uint8_t* columns, uint8_t width, uint8_t bytes,
+                     uint8_t color, const int W, const int P){
+    for(int col = 0; col < width; col++, x++, columns += bytes){
+        if(x < 0 || x >= W)
+            continue;
+
+        for(int i = 0; i < bytes; i++){
+            if(page + i < 0 || page + i >= P)
+                continue;
+
+            uint8_t* dst = &vram[(page + i) * W + x];
+            switch(color){
+                case SSD1306_BLACK: *dst &= ~columns[i]; break;
+                case SSD1306_WHITE: *dst |= columns[i]; break;
+                default:            *dst ^= columns[i]; break;
+            }
+        }
+    }
+}
+
+static void ssd1306_blit(ssd1306_t* disp, int16_t x, int16_t page, const uint8_t* columns, uint8_t width, uint8_t bytes,
+                         uint8_t color){
+    if(disp->strip)
+        return;
+
+    SSD1306_SPECIALISE(disp, ssd1306_blit_to(disp->vram, x, page, columns, width, bytes, color, W, P));
+}
+
+int16_t ssd1306_draw_char(ssd1306_t* disp, int16_t x, int16_t y, char c, const ssd1306_font_t* font, uint8_t color){
+    uint8_t index = ssd1306_glyph_index(font, c);
+    uint8_t first, width;
+    uint8_t shift = y & 0x07;
+    int16_t page = y >> 3;      /* floor, also for negative y */
+    int16_t x_end, y_end;
+
+    ssd1306_glyph_metrics(font, index, &first, &width);
+    const uint8_t* glyph = font->glyphs + (index * font->width + first) * font->pages;
+
+    x_end = x + width - 1;
+    y_end = y + font->pages * 8 - 1;
+    if(x_end >= 0 && x < disp->width && y_end >= 0 && y < disp->height){
+        if(shift == 0)
+            ssd1306_blit(disp, x, page, glyph, width, font->pages, color);
+        else if(width * (font->pages + 1) <= SSD1306_GLYPH_CACHE_BYTES)
+            ssd1306_blit(disp, x, page, ssd1306_glyph_cached(font, index, glyph, width, shift), width, font->pages + 1, color);
+        else{
+            /* too big for the cache, shift column by column */
+            uint8_t column[SSD1306_MAX_PAGES + 1];
+            for(int col = 0; col < width; col++){
+                ssd1306_glyph_shift(glyph + col * font->pages, font->pages, 1, shift, column);
+                ssd1306_blit(disp, x + col, page, column, 1, font->pages + 1, color);
+            }
+        }
+
+        ssd1306_mark_dirty(disp, x < 0 ? 0 : x, x_end >= disp->width ? disp->width - 1 : x_end,
+                           y < 0 ? 0 : y >> 3, y_end >= disp->height ? disp->pages - 1 : y_end >> 3);
+    }
+
+    return x + width + (font->metrics ? font->spacing : 0);
+}
+
+int16_t ssd1306_draw_string(ssd1306_t* disp, int16_t x, int16_t y, const char* str, const ssd1306_font_t* font, uint8_t color){
+    while(*str && x < disp->width)
+        x = ssd1306_draw_char(disp, x, y, *str++, font, color);
+
+    return x;
+}
+
+int16_t ssd1306_string_width(const char* str, const ssd1306_font_t* font){
+    int16_t width = 0;
+    uint8_t first, w;
+
+    if(!font->metrics)
+        return strlen(str) * font->width;
+
+    while(*str){
+        ssd1306_glyph_metrics(font, ssd1306_glyph_index(font, *str++), &first, &w);
+        width += w + font->spacing;
+    }
+
+    return width;
+}
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+Converts images into compressed ssd1306_bitmap_t assets (see ssd1306.h).
+
+    bitmap2c.py [--mask MASK] [--name NAME] [--mirror] IMAGE [IMAGE ...] > asset.h
+
+Several images make an animation: the first frame is stored whole, every
+following one as the XOR against its predecessor (SSD1306_BITMAP_DELTA)
+when that is smaller. PBM files (P1/P4) are read directly, set bits are lit
+pixels. Other formats need Pillow, bright pixels are lit. In the mask, lit
+pixels are opaque. Heights that are not a multiple of 8 are padded and
+masked out.
+
+Image x is taken as the vram column, which is also the panel view that
+ssd1306_emu_write_pbm dumps with the default init list. --mirror flips
+images taken from a panel with SEG remap (A1) set.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+def read_pbm(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+
+    # header: magic, width, height, with # comments
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        m = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(raw, pos)
+        if not m:
+            raise ValueError("%s: bad PBM header" % path)
+        tokens.append(m.group(2))
+        pos = m.end()
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+
+    if magic == b"P4":
+        body = raw[pos + 1:]
+        stride = (width + 7) // 8
+        return width, height, [[(body[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+                               for y in range(height)]
+    if magic == b"P1":
+        bits = [int(c) for c in re.sub(rb"#[^\n]*", b"", raw[pos:]).decode() if c in "01"]
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+    raise ValueError("%s: only P1/P4 PBM without Pillow" % path)
+
+
+def read_image(path, mirror=False):
+    """rows of 0/1 in vram column order"""
+    if os.path.splitext(path)[1].lower() == ".pbm":
+        width, height, rows = read_pbm(path)
+    else:
+        from PIL import Image
+        image = Image.open(path).convert("L")
+        width, height = image.size
+        pixels = image.load()
+        rows = [[1 if pixels[x, y] > 127 else 0 for x in range(width)] for y in range(height)]
+
+    if mirror:
+        rows = [row[::-1] for row in rows]
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    """vram layout: page major, one byte per column, LSB on top"""
+    pages = (height + 7) // 8
+    out = bytearray(width * pages)
+    for y in range(height):
+        for x in range(width):
+            if rows[y][x]:
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return pages, out
+
+
+def rle(data):
+    """header < 0x80: header + 1 literals follow, >= 0x80: next byte repeated header - 0x80 + 2 times"""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 129:
+            run += 1
+        # a pair inside literals is cheaper left as literals
+        if run >= 3 or (run == 2 and not literal):
+            flush()
+            out.append(0x80 + run - 2)
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def c_array(name, data):
+    lines = ["static const uint8_t %s[%d] = {" % (name, len(data))]
+    for i in range(0, len(data), 16):
+        lines.append("    " + " ".join("0x%02X," % b for b in data[i:i + 16]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="image to compressed ssd1306_bitmap_t")
+    parser.add_argument("images", nargs="+")
+    parser.add_argument("--mask", help="opacity mask, lit pixels are opaque")
+    parser.add_argument("--name", help="C name, defaults to the first file name")
+    parser.add_argument("--mirror", action="store_true", help="flip x, for images taken from a SEG remapped panel")
+    args = parser.parse_args()
+
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.images[0]))[0])
+    frames = []
+    for path in args.images:
+        width, height, rows = read_image(path, args.mirror)
+        if frames and (width, height) != frames[0][:2]:
+            sys.exit("%s: all frames must have the same size" % path)
+        frames.append((width, height, rows))
+    width, height = frames[0][:2]
+
+    mask = None
+    if args.mask:
+        mw, mh, mrows = read_image(args.mask, args.mirror)
+        if (mw, mh) != (width, height):
+            sys.exit("%s: mask size differs from the image" % args.mask)
+        mask = to_pages(width, height, mrows)[1]
+    elif height % 8:
+        mask = to_pages(width, height, [[1] * width for _ in range(height)])[1]
+
+    print("/* generated by tools/bitmap2c.py from %s */" % " ".join(os.path.basename(p) for p in args.images))
+    print()
+
+    mask_name = "NULL"
+    if mask is not None:
+        mask_name = "%s_mask" % name
+        print(c_array(mask_name, rle(mask)))
+        print()
+
+    entries = []
+    previous = None
+    raw_total = packed_total = 0
+    for index, (_, _, rows) in enumerate(frames):
+        pages, data = to_pages(width, height, rows)
+        packed, flags = rle(data), "0"
+
+        # delta frames XOR onto the previous one and ignore the mask
+        if previous is not None and mask is None:
+            delta = rle(bytes(a ^ b for a, b in zip(data, previous)))
+            if len(delta) < len(packed):
+                packed, flags = delta, "SSD1306_BITMAP_DELTA"
+        previous = data
+
+        data_name = "%s_%d" % (name, index) if len(frames) > 1 else "%s_data" % name
+        print(c_array(data_name, packed))
+        print()
+        entries.append("{ %s, %s, %d, %d, %s }" % (data_name, mask_name, width, pages, flags))
+        raw_total += len(data)
+        packed_total += len(packed)
+
+    if len(frames) > 1:
+        print("static const ssd1306_bitmap_t %s[%d] = {" % (name, len(frames)))
+        for entry in entries:
+            print("    %s," % entry)
+        print("};")
+    else:
+        print("static const ssd1306_bitmap_t %s = %s;" % (name, entries[0]))
+
+    sys.stderr.write("%s: %d frame(s), %d bytes raw, %d bytes packed\n" % (name, len(frames), raw_total, packed_total))
+
+
+if __name__ == "__main__":
+    main()